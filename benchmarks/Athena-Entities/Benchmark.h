@@ -0,0 +1,95 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace Benchmarks
+{
+    typedef void (*tBenchmarkFunction)();
+
+    struct tBenchmark
+    {
+        const char*         strName;
+        tBenchmarkFunction  function;
+    };
+
+    typedef std::vector<tBenchmark> tBenchmarksList;
+
+
+    inline tBenchmarksList& getBenchmarks()
+    {
+        static tBenchmarksList benchmarks;
+        return benchmarks;
+    }
+
+
+    struct Registration
+    {
+        Registration(const char* strName, tBenchmarkFunction function)
+        {
+            tBenchmark benchmark = { strName, function };
+            getBenchmarks().push_back(benchmark);
+        }
+    };
+
+
+    // Measures the wall-clock time (the benchmarks can use several threads)
+    class Timer
+    {
+    public:
+        Timer()
+        : m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        inline void reset()
+        {
+            m_start = std::chrono::steady_clock::now();
+        }
+
+        inline double getMilliseconds() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+
+    inline void report(const char* strCase, double milliseconds, unsigned int nbIterations)
+    {
+        std::printf("    %-48s %10.3f ms  (%10.4f ms/iteration)\n", strCase, milliseconds,
+                    milliseconds / nbIterations);
+    }
+
+
+    inline int runAll(const char* strFilter = 0)
+    {
+        tBenchmarksList& benchmarks = getBenchmarks();
+
+        for (unsigned int i = 0; i < benchmarks.size(); ++i)
+        {
+            if (strFilter && !std::strstr(benchmarks[i].strName, strFilter))
+                continue;
+
+            std::printf("%s\n", benchmarks[i].strName);
+            benchmarks[i].function();
+        }
+
+        return 0;
+    }
+}
+
+
+#define BENCHMARK(NAME)                                                                 \
+    static void benchmark##NAME();                                                      \
+    static Benchmarks::Registration registration##NAME(#NAME, benchmark##NAME);         \
+    static void benchmark##NAME()
+
+
+#endif
@@ -0,0 +1,129 @@
+#include <Athena-Entities/Entity.h>
+#include "../Benchmark.h"
+#include "../environments/BenchmarksEnvironment.h"
+#include <sstream>
+
+
+using namespace Athena::Entities;
+using namespace Benchmarks;
+
+
+// Returns the names of 'nbEntities' entities
+static std::vector<std::string> createNames(unsigned int nbEntities)
+{
+    std::vector<std::string> names;
+    names.reserve(nbEntities);
+
+    for (unsigned int i = 0; i < nbEntities; ++i)
+    {
+        std::ostringstream str;
+        str << "entity" << i;
+        names.push_back(str.str());
+    }
+
+    return names;
+}
+
+
+BENCHMARK(EntitiesManagement)
+{
+    const unsigned int NB_ENTITIES[] = { 1000, 10000, 100000 };
+
+    for (unsigned int n = 0; n < sizeof(NB_ENTITIES) / sizeof(unsigned int); ++n)
+    {
+        BenchmarksEnvironment env;
+
+        std::vector<std::string> names = createNames(NB_ENTITIES[n]);
+        std::vector<Entity*> entities;
+        entities.reserve(names.size());
+
+        std::ostringstream str;
+        str << " (" << names.size() << " entities)";
+
+        // Creation
+        Timer timer;
+
+        for (unsigned int i = 0; i < names.size(); ++i)
+            entities.push_back(env.pScene->create(names[i]));
+
+        report(("create" + str.str()).c_str(), timer.getMilliseconds(), (unsigned int) names.size());
+
+        // Lookup by name
+        timer.reset();
+
+        unsigned int nbFound = 0;
+        for (unsigned int i = 0; i < names.size(); ++i)
+        {
+            if (env.pScene->getEntity(names[i]))
+                ++nbFound;
+        }
+
+        report(("getEntity(name)" + str.str()).c_str(), timer.getMilliseconds(), nbFound);
+
+        // Destruction by name of half of the entities, in creation order
+        timer.reset();
+
+        for (unsigned int i = 0; i < names.size(); i += 2)
+            env.pScene->destroy(names[i]);
+
+        report(("destroy(name)" + str.str()).c_str(), timer.getMilliseconds(),
+               (unsigned int) names.size() / 2);
+
+        // Destruction of the other half, in creation order
+        timer.reset();
+
+        for (unsigned int i = 1; i < entities.size(); i += 2)
+            env.pScene->destroy(entities[i]);
+
+        report(("destroy(entity)" + str.str()).c_str(), timer.getMilliseconds(),
+               (unsigned int) entities.size() / 2);
+    }
+}
+
+
+BENCHMARK(HierarchiesDestruction)
+{
+    const unsigned int NB_CHILDREN[] = { 10, 100, 1000 };
+
+    for (unsigned int n = 0; n < sizeof(NB_CHILDREN) / sizeof(unsigned int); ++n)
+    {
+        BenchmarksEnvironment env;
+
+        std::vector<std::string> names = createNames(100000);
+
+        std::ostringstream str;
+        str << " (" << NB_CHILDREN[n] << " children per root)";
+
+        // Roots with children, each child having a component linked to its transforms
+        unsigned int nbRoots = (unsigned int) names.size() / (NB_CHILDREN[n] + 1);
+        unsigned int index = 0;
+
+        for (unsigned int i = 0; i < nbRoots; ++i)
+        {
+            Entity* pRoot = env.pScene->create(names[index++]);
+
+            for (unsigned int j = 0; j < NB_CHILDREN[n]; ++j)
+            {
+                Entity* pChild = env.pScene->create(names[index++], pRoot);
+
+                Component* pComponent = Component::create("Comp", pChild->getComponentsList());
+                pComponent->setTransforms(pChild->getTransforms());
+            }
+        }
+
+        // Destruction of the first half of the roots, one by one
+        Timer timer;
+
+        for (unsigned int i = 0; i < nbRoots / 2; ++i)
+            env.pScene->destroy(names[i * (NB_CHILDREN[n] + 1)]);
+
+        report(("destroy(root)" + str.str()).c_str(), timer.getMilliseconds(), nbRoots / 2);
+
+        // Destruction of the other half at once
+        timer.reset();
+
+        env.pScene->destroyAll();
+
+        report(("destroyAll()" + str.str()).c_str(), timer.getMilliseconds(), 1);
+    }
+}
@@ -0,0 +1,84 @@
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Prefab.h>
+#include <Athena-Entities/Serialization.h>
+#include <Athena-Entities/Transforms.h>
+#include "../Benchmark.h"
+#include "../environments/BenchmarksEnvironment.h"
+#include <sstream>
+
+
+using namespace Athena::Entities;
+using namespace Benchmarks;
+
+
+// Creates an entity with 'nbChildren' children, each one with a component linked to the
+// Transforms of the root
+static Entity* createTemplate(Scene* pScene, unsigned int nbChildren)
+{
+    Entity* pRoot = pScene->create("template");
+    pRoot->getTransforms()->setPosition(1.0f, 2.0f, 3.0f);
+
+    for (unsigned int i = 0; i < nbChildren; ++i)
+    {
+        std::ostringstream name;
+        name << "part" << i;
+
+        Entity* pChild = pScene->create(name.str(), pRoot);
+        pChild->getTransforms()->setPosition(0.0f, (float) i, 0.0f);
+
+        Component* pComponent = new Component("Part", pChild->getComponentsList());
+        pComponent->setTransforms(pRoot->getTransforms());
+    }
+
+    return pRoot;
+}
+
+
+BENCHMARK(PrefabInstantiation)
+{
+    const unsigned int NB_INSTANCES = 1000;
+    const unsigned int NB_CHILDREN = 8;
+
+    std::ostringstream str;
+    str << " (" << NB_INSTANCES << " x " << (NB_CHILDREN + 1) << " entities)";
+
+    // Re-parsing of the JSON representation for each instance
+    {
+        BenchmarksEnvironment env;
+
+        Entity* pTemplate = createTemplate(env.pScene, NB_CHILDREN);
+        std::string json = toJSON(pTemplate);
+        env.pScene->destroy(pTemplate);
+
+        Timer timer;
+
+        for (unsigned int i = 0; i < NB_INSTANCES; ++i)
+        {
+            Entity* pInstance = fromJSON(json, env.pScene);
+            env.pScene->destroy(pInstance);
+        }
+
+        report(("fromJSON(entity) + destroy" + str.str()).c_str(), timer.getMilliseconds(),
+               NB_INSTANCES);
+    }
+
+    // Instantiation of a compiled prefab
+    {
+        BenchmarksEnvironment env;
+
+        Entity* pTemplate = createTemplate(env.pScene, NB_CHILDREN);
+        Prefab prefab(pTemplate);
+        env.pScene->destroy(pTemplate);
+
+        Timer timer;
+
+        for (unsigned int i = 0; i < NB_INSTANCES; ++i)
+        {
+            Entity* pInstance = prefab.instantiate("instance", env.pScene);
+            env.pScene->destroy(pInstance);
+        }
+
+        report(("Prefab::instantiate() + destroy" + str.str()).c_str(), timer.getMilliseconds(),
+               NB_INSTANCES);
+    }
+}
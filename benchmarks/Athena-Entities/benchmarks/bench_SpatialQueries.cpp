@@ -0,0 +1,210 @@
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include "../Benchmark.h"
+#include "../environments/BenchmarksEnvironment.h"
+#include <sstream>
+
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace Benchmarks;
+
+
+// Deterministic pseudo-random positions in a cube of 'size' units
+static Vector3 randomPosition(unsigned int& seed, Real size)
+{
+    Vector3 position;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        position[i] = (seed >> 8) / Real(1 << 24) * size;
+    }
+
+    return position;
+}
+
+
+BENCHMARK(SpatialQueries)
+{
+    const unsigned int NB_ENTITIES[] = { 1000, 10000, 100000 };
+    const unsigned int NB_QUERIES = 1000;
+    const Real WORLD_SIZE = 1000.0f;
+    const Real RADIUS = 20.0f;
+
+    for (unsigned int n = 0; n < sizeof(NB_ENTITIES) / sizeof(unsigned int); ++n)
+    {
+        BenchmarksEnvironment env;
+
+        std::ostringstream str;
+        str << " (" << NB_ENTITIES[n] << " entities)";
+
+        unsigned int seed = 42;
+        std::vector<Entity*> entities;
+        entities.reserve(NB_ENTITIES[n]);
+
+        for (unsigned int i = 0; i < NB_ENTITIES[n]; ++i)
+        {
+            std::ostringstream name;
+            name << "entity" << i;
+
+            Entity* pEntity = env.pScene->create(name.str());
+            pEntity->getTransforms()->setPosition(randomPosition(seed, WORLD_SIZE));
+            entities.push_back(pEntity);
+        }
+
+        env.pScene->updateTransforms();
+
+        std::vector<Vector3> centers;
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+            centers.push_back(randomPosition(seed, WORLD_SIZE));
+
+        // Radius queries by going through all the entities
+        Timer timer;
+
+        unsigned int nbFound = 0;
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+        {
+            for (unsigned int j = 0; j < entities.size(); ++j)
+            {
+                if (entities[j]->getTransforms()->getWorldPosition().squaredDistance(centers[i]) <= RADIUS * RADIUS)
+                    ++nbFound;
+            }
+        }
+
+        report(("radius (scan)" + str.str()).c_str(), timer.getMilliseconds(), NB_QUERIES);
+
+        // Construction of the index
+        timer.reset();
+
+        env.pScene->enableSpatialIndex(true, RADIUS);
+        env.pScene->getSpatialIndex();
+
+        report(("enableSpatialIndex()" + str.str()).c_str(), timer.getMilliseconds(), 1);
+
+        // Radius queries using the index
+        timer.reset();
+
+        Entity::tEntitiesList found;
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+        {
+            found.clear();
+            env.pScene->getEntitiesInRadius(centers[i], RADIUS, found);
+        }
+
+        report(("radius (index)" + str.str()).c_str(), timer.getMilliseconds(), NB_QUERIES);
+
+        // Nearest entities using the index
+        timer.reset();
+
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+        {
+            found.clear();
+            env.pScene->getNearestEntities(centers[i], 8, found);
+        }
+
+        report(("nearest 8 (index)" + str.str()).c_str(), timer.getMilliseconds(), NB_QUERIES);
+
+        // Update of the index after 1% of the entities moved
+        for (unsigned int i = 0; i < entities.size(); i += 100)
+            entities[i]->getTransforms()->setPosition(randomPosition(seed, WORLD_SIZE));
+
+        timer.reset();
+
+        env.pScene->getSpatialIndex();
+
+        report(("index update (1% moved)" + str.str()).c_str(), timer.getMilliseconds(),
+               (unsigned int) entities.size() / 100);
+    }
+}
+
+
+BENCHMARK(BoundsQueries)
+{
+    const unsigned int NB_ENTITIES[] = { 1000, 10000, 100000 };
+    const unsigned int NB_QUERIES = 1000;
+    const Real WORLD_SIZE = 1000.0f;
+
+    for (unsigned int n = 0; n < sizeof(NB_ENTITIES) / sizeof(unsigned int); ++n)
+    {
+        BenchmarksEnvironment env;
+
+        std::ostringstream str;
+        str << " (" << NB_ENTITIES[n] << " entities)";
+
+        unsigned int seed = 42;
+        std::vector<Entity*> entities;
+        entities.reserve(NB_ENTITIES[n]);
+
+        env.pScene->enableSpatialIndex(true, 20.0f);
+
+        for (unsigned int i = 0; i < NB_ENTITIES[n]; ++i)
+        {
+            std::ostringstream name;
+            name << "entity" << i;
+
+            Entity* pEntity = env.pScene->create(name.str());
+            pEntity->getTransforms()->setPosition(randomPosition(seed, WORLD_SIZE));
+            pEntity->setBounds(tBounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)));
+            entities.push_back(pEntity);
+        }
+
+        // Construction of the hierarchy
+        Timer timer;
+
+        env.pScene->getBoundsHierarchy();
+
+        report(("hierarchy construction" + str.str()).c_str(), timer.getMilliseconds(), 1);
+
+        // Nearest hit of rays going through the world
+        std::vector<Vector3> origins;
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+            origins.push_back(randomPosition(seed, WORLD_SIZE));
+
+        BoundsHierarchy::tRayHit hit;
+
+        timer.reset();
+
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+            env.pScene->castRay(origins[i], Vector3::UNIT_X, WORLD_SIZE, &hit, 1);
+
+        report(("castRay (nearest)" + str.str()).c_str(), timer.getMilliseconds(), NB_QUERIES);
+
+        // Frustums covering 1% of the world
+        std::vector<Entity*> visible(NB_ENTITIES[n]);
+
+        timer.reset();
+
+        for (unsigned int i = 0; i < NB_QUERIES; ++i)
+        {
+            tFrustum frustum;
+            Real halfSize = WORLD_SIZE * 0.108f;
+
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                frustum.planes[j * 2].normal = Vector3::ZERO;
+                frustum.planes[j * 2].normal[j] = 1.0f;
+                frustum.planes[j * 2].d = halfSize - origins[i][j];
+
+                frustum.planes[j * 2 + 1].normal = Vector3::ZERO;
+                frustum.planes[j * 2 + 1].normal[j] = -1.0f;
+                frustum.planes[j * 2 + 1].d = halfSize + origins[i][j];
+            }
+
+            env.pScene->getEntitiesInFrustum(frustum, &visible[0], (unsigned int) visible.size());
+        }
+
+        report(("getEntitiesInFrustum" + str.str()).c_str(), timer.getMilliseconds(), NB_QUERIES);
+
+        // Refit after 10% of the entities moved a little
+        for (unsigned int i = 0; i < entities.size(); i += 10)
+            entities[i]->getTransforms()->translate(Vector3(0.5f, 0.0f, 0.0f));
+
+        timer.reset();
+
+        env.pScene->getBoundsHierarchy();
+
+        report(("hierarchy update (10% moved)" + str.str()).c_str(), timer.getMilliseconds(),
+               (unsigned int) entities.size() / 10);
+    }
+}
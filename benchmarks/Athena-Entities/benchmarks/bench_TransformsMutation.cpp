@@ -0,0 +1,137 @@
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/TransformsBatch.h>
+#include "../Benchmark.h"
+#include "../environments/BenchmarksEnvironment.h"
+#include <sstream>
+
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace Benchmarks;
+
+
+static const unsigned int NB_ITERATIONS = 100;
+
+
+// Create 'nbRoots' entities with 'nbChildren' children each, and returns the roots
+static std::vector<Entity*> createEntities(Scene* pScene, unsigned int nbRoots,
+                                           unsigned int nbChildren)
+{
+    std::vector<Entity*> roots;
+
+    for (unsigned int i = 0; i < nbRoots; ++i)
+    {
+        std::ostringstream str;
+        str << "root" << i;
+
+        Entity* pRoot = pScene->create(str.str());
+        roots.push_back(pRoot);
+
+        for (unsigned int j = 0; j < nbChildren; ++j)
+        {
+            std::ostringstream str2;
+            str2 << "child" << i << "_" << j;
+
+            pScene->create(str2.str(), pRoot);
+        }
+    }
+
+    return roots;
+}
+
+
+// Simulates the replication of the full transforms of all the roots, then the consumption
+// of the world transforms (the latter makes the entities up-to-date for the next round)
+static void consume(Scene* pScene)
+{
+    pScene->updateTransforms();
+}
+
+
+BENCHMARK(TransformsReplication)
+{
+    BenchmarksEnvironment env;
+
+    // 2000 roots with 5 children each
+    std::vector<Entity*> roots = createEntities(env.pScene, 2000, 5);
+
+    Quaternion orientation(Degree(10.0f), Vector3::UNIT_Y);
+    Vector3 scale(1.0f, 2.0f, 1.0f);
+    double total;
+
+    // Separate setters
+    total = 0.0;
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        Timer timer;
+
+        for (unsigned int j = 0; j < roots.size(); ++j)
+        {
+            Transforms* pTransforms = roots[j]->getTransforms();
+            pTransforms->setPosition(Real(i), Real(j), 0.0f);
+            pTransforms->setOrientation(orientation);
+            pTransforms->setScale(scale);
+        }
+
+        total += timer.getMilliseconds();
+        consume(env.pScene);
+    }
+
+    report("setPosition + setOrientation + setScale", total, NB_ITERATIONS);
+
+    // One setter
+    total = 0.0;
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        Timer timer;
+
+        for (unsigned int j = 0; j < roots.size(); ++j)
+            roots[j]->getTransforms()->setTransform(Vector3(Real(i), Real(j), 0.0f), orientation, scale);
+
+        total += timer.getMilliseconds();
+        consume(env.pScene);
+    }
+
+    report("setTransform", total, NB_ITERATIONS);
+
+    // Batch, with several updates of the same entities
+    total = 0.0;
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        Timer timer;
+
+        {
+            TransformsBatch batch(env.pScene);
+
+            for (unsigned int k = 0; k < 2; ++k)
+            {
+                for (unsigned int j = 0; j < roots.size(); ++j)
+                    roots[j]->getTransforms()->setTransform(Vector3(Real(i), Real(j), Real(k)), orientation, scale);
+            }
+        }
+
+        total += timer.getMilliseconds();
+        consume(env.pScene);
+    }
+
+    report("TransformsBatch + setTransform (x2)", total, NB_ITERATIONS);
+
+    // Same without batch
+    total = 0.0;
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        Timer timer;
+
+        for (unsigned int k = 0; k < 2; ++k)
+        {
+            for (unsigned int j = 0; j < roots.size(); ++j)
+                roots[j]->getTransforms()->setTransform(Vector3(Real(i), Real(j), Real(k)), orientation, scale);
+        }
+
+        total += timer.getMilliseconds();
+        consume(env.pScene);
+    }
+
+    report("setTransform (x2)", total, NB_ITERATIONS);
+}
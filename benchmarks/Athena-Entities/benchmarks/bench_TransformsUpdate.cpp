@@ -0,0 +1,209 @@
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include "../Benchmark.h"
+#include "../environments/BenchmarksEnvironment.h"
+#include <sstream>
+#include <thread>
+
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace Benchmarks;
+
+
+static const unsigned int NB_ITERATIONS = 100;
+
+
+static std::string makeName(unsigned int index)
+{
+    std::ostringstream str;
+    str << "entity" << index;
+    return str.str();
+}
+
+
+// Create 'nbChains' chains of 'depth' entities
+static void createDeepHierarchy(Scene* pScene, unsigned int nbChains, unsigned int depth,
+                                std::vector<Entity*> &roots, std::vector<Entity*> &entities)
+{
+    for (unsigned int i = 0; i < nbChains; ++i)
+    {
+        Entity* pParent = 0;
+        for (unsigned int j = 0; j < depth; ++j)
+        {
+            Entity* pEntity = pScene->create(makeName(entities.size()), pParent);
+            pEntity->getTransforms()->setPosition(1.0f, 0.0f, 0.0f);
+            pEntity->getTransforms()->setOrientation(Quaternion(Degree(1.0f), Vector3::UNIT_Y));
+
+            if (!pParent)
+                roots.push_back(pEntity);
+
+            entities.push_back(pEntity);
+            pParent = pEntity;
+        }
+    }
+}
+
+
+// Create 'nbRoots' entities with 'nbChildren' children each
+static void createWideHierarchy(Scene* pScene, unsigned int nbRoots, unsigned int nbChildren,
+                                std::vector<Entity*> &roots, std::vector<Entity*> &entities)
+{
+    for (unsigned int i = 0; i < nbRoots; ++i)
+    {
+        Entity* pRoot = pScene->create(makeName(entities.size()));
+        roots.push_back(pRoot);
+        entities.push_back(pRoot);
+
+        for (unsigned int j = 0; j < nbChildren; ++j)
+        {
+            Entity* pEntity = pScene->create(makeName(entities.size()), pRoot);
+            pEntity->getTransforms()->setPosition(1.0f, 0.0f, 0.0f);
+            entities.push_back(pEntity);
+        }
+    }
+}
+
+
+static void moveRoots(const std::vector<Entity*> &roots)
+{
+    for (unsigned int i = 0; i < roots.size(); ++i)
+        roots[i]->getTransforms()->translate(0.1f, 0.0f, 0.0f);
+}
+
+
+// Retrieve the world position of all the entities, each one computing it on demand
+static double runLazy(const std::vector<Entity*> &roots, const std::vector<Entity*> &entities)
+{
+    Real sum = 0.0f;
+    Timer timer;
+
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        moveRoots(roots);
+
+        for (unsigned int j = 0; j < entities.size(); ++j)
+            sum += entities[j]->getTransforms()->getWorldPosition().x;
+    }
+
+    double result = timer.getMilliseconds();
+
+    // Prevent the compiler to optimize the loop away
+    if (sum == 0.0f)
+        std::printf("    (unexpected sum)\n");
+
+    return result;
+}
+
+
+// Retrieve the world position of all the entities, after a batched update of the scene
+static double runBatched(Scene* pScene, const std::vector<Entity*> &roots,
+                         const std::vector<Entity*> &entities)
+{
+    Real sum = 0.0f;
+    Timer timer;
+
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        moveRoots(roots);
+
+        pScene->updateTransforms();
+
+        for (unsigned int j = 0; j < entities.size(); ++j)
+            sum += entities[j]->getTransforms()->getWorldPosition().x;
+    }
+
+    double result = timer.getMilliseconds();
+
+    if (sum == 0.0f)
+        std::printf("    (unexpected sum)\n");
+
+    return result;
+}
+
+
+BENCHMARK(TransformsUpdateDeepHierarchy)
+{
+    BenchmarksEnvironment env;
+    std::vector<Entity*> roots;
+    std::vector<Entity*> entities;
+
+    // 20 chains of 100 entities
+    createDeepHierarchy(env.pScene, 20, 100, roots, entities);
+
+    report("lazy (getWorldPosition)", runLazy(roots, entities), NB_ITERATIONS);
+    report("batched (Scene::updateTransforms)", runBatched(env.pScene, roots, entities), NB_ITERATIONS);
+}
+
+
+BENCHMARK(TransformsUpdateWideHierarchy)
+{
+    BenchmarksEnvironment env;
+    std::vector<Entity*> roots;
+    std::vector<Entity*> entities;
+
+    // 2 roots with 1000 children each
+    createWideHierarchy(env.pScene, 2, 1000, roots, entities);
+
+    report("lazy (getWorldPosition)", runLazy(roots, entities), NB_ITERATIONS);
+    report("batched (Scene::updateTransforms)", runBatched(env.pScene, roots, entities), NB_ITERATIONS);
+}
+
+
+BENCHMARK(TransformsUpdateLargeScene)
+{
+    BenchmarksEnvironment env;
+    std::vector<Entity*> roots;
+    std::vector<Entity*> entities;
+
+    // 1000 roots with 99 children each (100k entities)
+    createWideHierarchy(env.pScene, 1000, 99, roots, entities);
+
+    std::printf("    SIMD width: %u\n", TransformsStore::SIMD_WIDTH);
+
+    // Only measure the update pass itself
+    double total = 0.0;
+    for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+    {
+        moveRoots(roots);
+
+        Timer timer;
+        env.pScene->updateTransforms();
+        total += timer.getMilliseconds();
+    }
+
+    report("Scene::updateTransforms", total, NB_ITERATIONS);
+}
+
+
+BENCHMARK(TransformsUpdateThreads)
+{
+    BenchmarksEnvironment env;
+    std::vector<Entity*> roots;
+    std::vector<Entity*> entities;
+
+    // 2000 roots with 49 children each (100k entities)
+    createWideHierarchy(env.pScene, 2000, 49, roots, entities);
+
+    unsigned int nbMaxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (unsigned int nbThreads = 1; nbThreads <= nbMaxThreads; nbThreads *= 2)
+    {
+        env.pScene->setNbTransformsThreads(nbThreads);
+
+        double total = 0.0;
+        for (unsigned int i = 0; i < NB_ITERATIONS; ++i)
+        {
+            moveRoots(roots);
+
+            Timer timer;
+            env.pScene->updateTransforms();
+            total += timer.getMilliseconds();
+        }
+
+        std::ostringstream str;
+        str << nbThreads << " thread(s)";
+
+        report(str.str().c_str(), total, NB_ITERATIONS);
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef _BENCHMARKSENVIRONMENT_H_
+#define _BENCHMARKSENVIRONMENT_H_
+
+#include <Athena-Entities/ComponentsManager.h>
+#include <Athena-Entities/ScenesManager.h>
+#include <Athena-Entities/Scene.h>
+#include <Athena-Core/Log/LogManager.h>
+
+
+struct BenchmarksEnvironment
+{
+    Athena::Entities::Scene* pScene;
+    Athena::Entities::ComponentsManager* pComponentsManager;
+    Athena::Entities::ScenesManager* pScenesManager;
+    Athena::Log::LogManager* pLogManager;
+
+    BenchmarksEnvironment()
+    : pScene(0)
+    {
+        pLogManager = new Athena::Log::LogManager();
+
+        pComponentsManager = new Athena::Entities::ComponentsManager();
+        pScenesManager = new Athena::Entities::ScenesManager();
+
+        pScene = new Athena::Entities::Scene("default");
+    }
+
+    ~BenchmarksEnvironment()
+    {
+        delete pScene;
+
+        delete pScenesManager;
+        delete pComponentsManager;
+        delete pLogManager;
+    }
+};
+
+
+#endif
@@ -0,0 +1,6 @@
+#include "Benchmark.h"
+
+int main(int argc, char** argv)
+{
+    return Benchmarks::runAll(argc > 1 ? argv[1] : 0);
+}
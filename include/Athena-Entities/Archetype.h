@@ -0,0 +1,183 @@
+/** @file   Archetype.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::Archetype'
+*/
+
+#ifndef _ATHENA_ENTITIES_ARCHETYPE_H_
+#define _ATHENA_ENTITIES_ARCHETYPE_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/Component.h>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Index of the entities of a scene having the same set of types of components
+///
+/// The entities are referenced by chunks of CHUNK_SIZE entities. Each chunk contains one
+/// array of pointers to the components per type of the set (a 'column'), so a system can
+/// go through the components of a type in a chunk without searching the components lists
+/// of the entities.
+///
+/// The chunks don't store the components themselves: they are still allocated by the
+/// components manager and owned by the components lists of their entities, so the
+/// columns don't point into contiguous memory. Registering a type with a pool (see
+/// ComponentsManager::registerType(unsigned int)) keeps its components close to each
+/// other. The entities are moved inside the archetype when one of them is removed, to
+/// keep the chunks compact.
+///
+/// @remark The archetypes are managed by the scenes (see Scene::enableArchetypes())
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL Archetype
+{
+    //_____ Internal types __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  The sorted list of the types of the components of the entities (a type
+    ///         appears several times if the entities have several components of that
+    ///         type)
+    //------------------------------------------------------------------------------------
+    typedef std::vector<Component::tTypeID> tSignature;
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  signature   The types of the components of the entities
+    //------------------------------------------------------------------------------------
+    Archetype(const tSignature& signature);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~Archetype();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the types of the components of the entities
+    //------------------------------------------------------------------------------------
+    inline const tSignature& getSignature() const
+    {
+        return m_signature;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the column containing the components of a type
+    ///
+    /// @param  typeID      The identifier of the type
+    /// @param  occurrence  Index of the component among the ones of that type of each
+    ///                     entity
+    /// @return             The column, INVALID_COLUMN if the entities don't have such a
+    ///                     component
+    //------------------------------------------------------------------------------------
+    unsigned int getColumn(Component::tTypeID typeID, unsigned int occurrence = 0) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the entities have a component of the given type
+    //------------------------------------------------------------------------------------
+    inline bool hasType(Component::tTypeID typeID) const
+    {
+        return (getColumn(typeID) != INVALID_COLUMN);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of entities in the archetype
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbEntities() const
+    {
+        return m_nbEntities;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of chunks
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbChunks() const
+    {
+        return (unsigned int) m_chunks.size();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of entities in a chunk
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbEntities(unsigned int chunk) const
+    {
+        assert(chunk < getNbChunks());
+        return m_chunks[chunk].nbEntities;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the entities of a chunk (getNbEntities(chunk) of them)
+    //------------------------------------------------------------------------------------
+    inline Entity* const* getEntities(unsigned int chunk) const
+    {
+        assert(chunk < getNbChunks());
+        return m_chunks[chunk].pEntities;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the components of a column in a chunk (getNbEntities(chunk) of
+    ///         them, in the same order than the entities)
+    //------------------------------------------------------------------------------------
+    inline Component* const* getComponents(unsigned int chunk, unsigned int column) const
+    {
+        assert(chunk < getNbChunks());
+        assert(column < m_signature.size());
+        return m_chunks[chunk].pComponents + column * CHUNK_SIZE;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Adds an entity in the archetype
+    ///
+    /// @param  pEntity     The entity
+    /// @param  components  The components of the entity, in the order of the signature
+    /// @return             The index of the entity in the archetype
+    //------------------------------------------------------------------------------------
+    unsigned int _addEntity(Entity* pEntity, Component* const* components);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Removes an entity from the archetype
+    ///
+    /// The last entity of the archetype is moved in its place.
+    ///
+    /// @param  index       The index of the entity in the archetype
+    /// @return             The entity moved at that index, 0 if none
+    //------------------------------------------------------------------------------------
+    Entity* _removeEntity(unsigned int index);
+
+
+    //_____ Constants __________
+public:
+    static const unsigned int CHUNK_SIZE = 64;                  ///< Number of entities in a chunk
+    static const unsigned int INVALID_COLUMN = 0xFFFFFFFF;      ///< See getColumn()
+
+
+    //_____ Internal types __________
+private:
+    struct tChunk
+    {
+        Entity**        pEntities;      ///< The entities
+        Component**     pComponents;    ///< The columns of pointers to the components, one after the other
+        unsigned int    nbEntities;
+    };
+
+
+    //_____ Attributes __________
+private:
+    tSignature          m_signature;
+    std::vector<tChunk> m_chunks;
+    unsigned int        m_nbEntities;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,223 @@
+/** @file   BoundsHierarchy.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::BoundsHierarchy'
+*/
+
+#ifndef _ATHENA_ENTITIES_BOUNDSHIERARCHY_H_
+#define _ATHENA_ENTITIES_BOUNDSHIERARCHY_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/tBounds.h>
+#include <Athena-Entities/tFrustum.h>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Hierarchy of the world bounds of the entities of a scene, used for the ray
+///         casts and the frustum culling
+///
+/// The bounds are the leaves of a binary tree, in which each node contains the bounds of
+/// its children. A new leaf is inserted where it enlarges the nodes the least. When the
+/// bounds of an entity change, its leaf is refitted in place (only its ancestors are
+/// updated) while it stays inside the bounds of its parent, and reinserted otherwise, so
+/// the hierarchy doesn't degrade when the entities move far away.
+///
+/// The queries write their results in buffers provided by the caller, and don't allocate
+/// any memory once the traversal stack has grown to the depth of the hierarchy.
+///
+/// @remark The hierarchy is maintained by the scene (see Scene::enableSpatialIndex()),
+///         which updates it before each query with the entities that moved or whose
+///         bounds changed since the previous one
+/// @remark The queries share the traversal stack: they must not be done concurrently
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL BoundsHierarchy
+{
+    //_____ Internal types __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  An entity hit by a ray
+    //------------------------------------------------------------------------------------
+    struct tRayHit
+    {
+        Entity*     pEntity;    ///< The entity
+        Math::Real  distance;   ///< Distance at which the ray enters the bounds of the
+                                ///  entity (0 if the ray starts inside them)
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    BoundsHierarchy();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~BoundsHierarchy();
+
+
+    //_____ Queries __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities whose bounds are hit by a ray
+    ///
+    /// @param  origin      Origin of the ray
+    /// @param  direction   Direction of the ray (the distances are expressed in units of
+    ///                     its length)
+    /// @param  maxDistance Length of the ray
+    /// @param  pHits       The buffer in which the hits are written, from the nearest one
+    /// @param  maxHits     Size of the buffer
+    /// @return             The number of hits written in the buffer (only the 'maxHits'
+    ///                     nearest ones are kept)
+    //------------------------------------------------------------------------------------
+    unsigned int castRay(const Math::Vector3& origin, const Math::Vector3& direction,
+                         Math::Real maxDistance, tRayHit* pHits, unsigned int maxHits) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities whose bounds are (at least partially) inside a
+    ///         frustum
+    ///
+    /// @param  frustum     The frustum
+    /// @param  pEntities   The buffer in which the entities are written (in no particular
+    ///                     order)
+    /// @param  maxEntities Size of the buffer
+    /// @return             The number of entities in the frustum, which can be greater
+    ///                     than 'maxEntities' (only the first ones are written in the
+    ///                     buffer)
+    //------------------------------------------------------------------------------------
+    unsigned int getEntitiesInFrustum(const tFrustum& frustum, Entity** pEntities,
+                                      unsigned int maxEntities) const;
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of entities in the hierarchy
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbEntities() const
+    {
+        return m_nbEntities;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the bounds containing all the entities of the hierarchy
+    //------------------------------------------------------------------------------------
+    inline const tBounds& getBounds() const
+    {
+        assert(m_root != NO_NODE);
+        return m_nodes[m_root].bounds;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the depth of the hierarchy (0 if empty, 1 with only one entity)
+    ///
+    /// @remark Goes through the whole hierarchy
+    //------------------------------------------------------------------------------------
+    unsigned int getDepth() const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if an entity is in the hierarchy
+    //------------------------------------------------------------------------------------
+    bool contains(Entity* pEntity) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the world bounds of an entity of the hierarchy
+    //------------------------------------------------------------------------------------
+    const tBounds& getBounds(Entity* pEntity) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Adds an entity in the hierarchy, or updates its world bounds
+    ///
+    /// @remark The entries are indexed by the handles of the entities: they must belong
+    ///         to the same scene
+    //------------------------------------------------------------------------------------
+    void _update(Entity* pEntity, const tBounds& bounds);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Removes an entity from the hierarchy (if it is in it)
+    //------------------------------------------------------------------------------------
+    void _remove(Entity* pEntity);
+
+
+    //_____ Internal types __________
+private:
+    struct tNode
+    {
+        tBounds         bounds;         ///< Bounds of the node
+        unsigned int    parent;         ///< Parent node (next free node if released)
+        unsigned int    children[2];    ///< Child nodes (NO_NODE for a leaf)
+        unsigned int    entry;          ///< Entry of a leaf
+    };
+
+    struct tEntry
+    {
+        Entity*         pEntity;        ///< The entity (0 if the entry isn't used)
+        unsigned int    leaf;           ///< Leaf containing the bounds of the entity
+    };
+
+
+    //_____ Methods __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a node is a leaf
+    //------------------------------------------------------------------------------------
+    inline bool isLeaf(unsigned int node) const
+    {
+        return (m_nodes[node].children[0] == NO_NODE);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns an unused node
+    //------------------------------------------------------------------------------------
+    unsigned int allocateNode();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Puts a node in the list of the unused ones
+    //------------------------------------------------------------------------------------
+    void releaseNode(unsigned int node);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Inserts a leaf in the tree
+    //------------------------------------------------------------------------------------
+    void insertLeaf(unsigned int leaf);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Removes a leaf from the tree (the leaf itself isn't released)
+    //------------------------------------------------------------------------------------
+    void removeLeaf(unsigned int leaf);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Updates the bounds of a node and of its ancestors, until one of them
+    ///         doesn't change
+    //------------------------------------------------------------------------------------
+    void refit(unsigned int node);
+
+
+    //_____ Constants __________
+private:
+    static const unsigned int NO_NODE = 0xFFFFFFFF;
+
+
+    //_____ Attributes __________
+private:
+    std::vector<tNode>                  m_nodes;
+    unsigned int                        m_root;
+    unsigned int                        m_freeNodes;    ///< First unused node
+    std::vector<tEntry>                 m_entries;      ///< The entries, indexed by the
+                                                        ///  handles of the entities
+    unsigned int                        m_nbEntities;
+    mutable std::vector<unsigned int>   m_stack;        ///< Traversal stack of the queries
+};
+
+}
+}
+
+#endif
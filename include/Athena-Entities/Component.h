@@ -9,6 +9,7 @@
 
 #include <Athena-Entities/Prerequisites.h>
 #include <Athena-Entities/tComponentID.h>
+#include <Athena-Entities/tHandle.h>
 #include <Athena-Core/Utils/Describable.h>
 #include <Athena-Core/Signals/SignalsList.h>
 
@@ -26,18 +27,42 @@ namespace Entities {
 /// Note that any component that MUST be affected by the transformations of the entity by
 /// default MUST invoke 'setTransforms(0)' in their constructor.
 ///
+/// Each class of component declares its own TYPE constant. It can also declare its own
+/// TYPE_ID constant, and set 'm_typeID' to it in its constructor: otherwise, an identifier
+/// is assigned to the type when it is registered with the components manager (see
+/// ComponentsManager::registerType()).
+///
 /// @remark Components are kept in lists (see ComponentsList)
 //----------------------------------------------------------------------------------------
 class ATHENA_ENTITIES_SYMBOL Component: public Utils::Describable
 {
     friend class ComponentsManager;
     friend class ComponentsList;
+    friend class Scene;
 
 
     //_____ Internal types __________
 public:
     typedef std::vector<Component*>                 tComponentsList;
     typedef Utils::VectorIterator<tComponentsList>  tComponentsIterator;
+    typedef unsigned int                            tTypeID;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  A link between two components
+    ///
+    /// Each link is a member of two intrusive lists: the links of the component that it
+    /// links from, and the links of the component that it links to. It can thus be
+    /// removed from both in constant time.
+    //------------------------------------------------------------------------------------
+    struct tLink
+    {
+        Component*  pFrom;      ///< The component linked to 'pTo'
+        Component*  pTo;        ///< The component to which 'pFrom' is linked
+        tLink*      pPrevTo;    ///< Previous link of 'pFrom'
+        tLink*      pNextTo;    ///< Next link of 'pFrom'
+        tLink*      pPrevBy;    ///< Previous link of 'pTo'
+        tLink*      pNextBy;    ///< Next link of 'pTo'
+    };
 
 
     //_____ Construction / Destruction __________
@@ -73,16 +98,63 @@ public:
     //-----------------------------------------------------------------------------------
     virtual const std::string getType() const { return TYPE; }
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the identifier of the type of the component (see
+    ///         ComponentsManager::getTypeID())
+    //-----------------------------------------------------------------------------------
+    inline tTypeID getTypeID() const { return m_typeID; }
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns a new identifier of type, used to initialize the TYPE_ID constant
+    ///         of a class of component
+    ///
+    /// @param  pParentTypeID   Address of the TYPE_ID constant of the parent class (it
+    ///                         might not be initialized yet), 0 if unknown. Without it,
+    ///                         component_cast() must use dynamic_cast to cast the
+    ///                         components of the class to their parent classes.
+    //-----------------------------------------------------------------------------------
+    static tTypeID _newTypeID(const tTypeID* pParentTypeID = 0);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns a new identifier of type, for a class which doesn't declare its
+    ///         own TYPE_ID (used by ComponentsManager::registerType())
+    ///
+    /// @param  pParentTypeID   Address of the TYPE_ID constant inherited by the class
+    //-----------------------------------------------------------------------------------
+    static tTypeID _newSubtypeID(const tTypeID* pParentTypeID);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Indicates if a type of component is derived from another one, by walking
+    ///         the identifiers of its parent types (used by component_cast())
+    ///
+    /// @param  typeID      Identifier of the type
+    /// @param  baseTypeID  Identifier of the other type
+    /// @param  bUnknown    Set to 'true' if the relation can't be determined from the
+    ///                     identifiers alone, 'false' otherwise
+    /// @return             'true' if the type is derived from the other one
+    //-----------------------------------------------------------------------------------
+    static bool _isDerivedType(tTypeID typeID, tTypeID baseTypeID, bool& bUnknown);
+
     //-----------------------------------------------------------------------------------
     /// @brief  Returns the id of the component
     //-----------------------------------------------------------------------------------
-    tComponentID getID() const { return m_id; }
+    inline const tComponentID& getID() const { return m_id; }
 
     //-----------------------------------------------------------------------------------
     /// @brief  Returns the name of the component
     //-----------------------------------------------------------------------------------
     inline const std::string& getName() const { return m_id.strName; }
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the handle of the component in its scene (invalid if the component
+    ///         doesn't belong to a scene)
+    ///
+    /// @remark The handle changes when the entity of the component is transfered to
+    ///         another scene
+    /// @see    Scene::getComponent(const tHandle&)
+    //-----------------------------------------------------------------------------------
+    inline const tHandle& getHandle() const { return m_handle; }
+
     //-----------------------------------------------------------------------------------
     /// @brief  Returns the list of which the component is a member
     //-----------------------------------------------------------------------------------
@@ -136,55 +208,55 @@ protected:
     ///
     /// @remark If you override it in your component, don't forget to call the base class
     ///         implementation!
+    /// @remark Not called when both components are destroyed at the same time, with
+    ///         their entities (see Scene::destroy()): the link is just released
     //-----------------------------------------------------------------------------------
     virtual void mustUnlinkComponent(Component* pComponent);
 
-    inline void addLinkTo(Component* pComponent)
-    {
-        assert(pComponent);
-        m_linked_to.push_back(pComponent);
-        pComponent->m_linked_by.push_back(this);
-    }
+    //-----------------------------------------------------------------------------------
+    /// @brief  Link this component to another one, which will ask this one to unlink it
+    ///         before its destruction (see mustUnlinkComponent())
+    //-----------------------------------------------------------------------------------
+    void addLinkTo(Component* pComponent);
 
-    inline void removeLinkTo(Component* pComponent)
-    {
-        assert(pComponent);
-
-        tComponentsList::iterator iter, iterEnd;
-        for (iter = m_linked_to.begin(), iterEnd = m_linked_to.end(); iter != iterEnd; ++iter)
-        {
-            if (*iter == pComponent)
-            {
-                m_linked_to.erase(iter);
-
-                tComponentsList::iterator iter2, iterEnd2;
-                for (iter2 = pComponent->m_linked_by.begin(), iterEnd2 = pComponent->m_linked_by.end();
-                     iter2 != iterEnd2; ++iter2)
-                {
-                    if (*iter2 == this)
-                    {
-                        pComponent->m_linked_by.erase(iter2);
-                        return;
-                    }
-                }
-
-                return;
-            }
-        }
-    }
+    //-----------------------------------------------------------------------------------
+    /// @brief  Remove a link from this component to another one
+    ///
+    /// Only searches the links of this component, not the ones of the other component:
+    /// the cost doesn't depend on the number of components linked to the other one.
+    //-----------------------------------------------------------------------------------
+    void removeLinkTo(Component* pComponent);
+
+    //-----------------------------------------------------------------------------------
+    /// @brief  Returns the first link to this component (use 'pNextBy' to get the next
+    ///         ones), 0 if none
+    //-----------------------------------------------------------------------------------
+    inline tLink* getFirstLinkBy() const { return m_pLinksBy; }
 
 private:
     void unlink();
 
+    //-----------------------------------------------------------------------------------
+    /// @brief  Remove a link from this component to another one from both lists, and
+    ///         release it (no one is notified)
+    //-----------------------------------------------------------------------------------
+    void releaseLink(tLink* pLink);
+
 
     //_____ Management of the signals list __________
 public:
     //------------------------------------------------------------------------------------
     /// @brief  Returns the signals list of the component
+    ///
+    /// The list is only created when first needed, most components not having any
+    /// listener.
     //------------------------------------------------------------------------------------
     inline Signals::SignalsList* getSignalsList()
     {
-        return &m_signals;
+        if (!m_pSignals)
+            m_pSignals = new Signals::SignalsList();
+
+        return m_pSignals;
     }
 
 
@@ -239,18 +311,79 @@ public:
     //_____ Constants __________
 public:
     static const std::string    TYPE;       ///< Type of component
+    static const tTypeID        TYPE_ID;    ///< Identifier of the type of component
+
+    static const tTypeID        INVALID_TYPE_ID = 0xFFFFFFFF;   ///< Never used by a type
 
 
     //_____ Attributes __________
 protected:
     tComponentID            m_id;           ///< ID of the component
+    tTypeID                 m_typeID;       ///< Identifier of the type of the component
     ComponentsList*         m_pList;        ///< The list containing that component
-    tComponentsList         m_linked_to;    ///< The list of components that this component links to
-    tComponentsList         m_linked_by;    ///< The list of components that links to this component
+    tLink*                  m_pLinksTo;     ///< The links from this component to others
+    tLink*                  m_pLinksBy;     ///< The links from other components to this one
     Transforms*             m_pTransforms;  ///< The transforms origin
-    Signals::SignalsList    m_signals;      ///< The signals list
+    Signals::SignalsList*   m_pSignals;     ///< The signals list (0 until needed)
+
+private:
+    tHandle                 m_handle;       ///< Handle of the component in its scene
+    tComponentsList*        m_pSceneList;   ///< The list of the scene containing the component
+    unsigned int            m_uiSceneIndex; ///< Index of the component in that list
+    ComponentsPool*         m_pPool;        ///< The pool containing the component (0 if allocated on the heap)
+};
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Identifier of the type of the components of a class, assigned when the class
+///         is registered with the components manager (see
+///         ComponentsManager::registerType())
+//----------------------------------------------------------------------------------------
+template<class TYPE>
+struct tComponentTypeID
+{
+    static Component::tTypeID value;    ///< Component::INVALID_TYPE_ID if not registered
 };
 
+template<class TYPE>
+Component::tTypeID tComponentTypeID<TYPE>::value = Component::INVALID_TYPE_ID;
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Cast a component to one of its subclasses
+///
+/// Walks the identifiers of the parent types of the component when TYPE is registered,
+/// and falls back to dynamic_cast only if TYPE isn't registered, or if the identifiers
+/// don't tell (a type declared without its parent, or a component created outside of
+/// the manager from a class which doesn't declare its own TYPE_ID).
+///
+/// @param  pComponent  The component
+/// @return             The component, 0 if it isn't of type TYPE
+//----------------------------------------------------------------------------------------
+template<class TYPE>
+inline TYPE* component_cast(Component* pComponent)
+{
+    if (!pComponent)
+        return 0;
+
+    if (tComponentTypeID<TYPE>::value != Component::INVALID_TYPE_ID)
+    {
+        bool bUnknown;
+        if (Component::_isDerivedType(pComponent->getTypeID(), tComponentTypeID<TYPE>::value, bUnknown))
+            return static_cast<TYPE*>(pComponent);
+        else if (!bUnknown)
+            return 0;
+    }
+
+    return dynamic_cast<TYPE*>(pComponent);
+}
+
+template<class TYPE>
+inline const TYPE* component_cast(const Component* pComponent)
+{
+    return component_cast<TYPE>(const_cast<Component*>(pComponent));
+}
+
 }
 }
 
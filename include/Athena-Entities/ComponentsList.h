@@ -9,6 +9,7 @@
 
 #include <Athena-Entities/Prerequisites.h>
 #include <Athena-Entities/Component.h>
+#include <unordered_map>
 
 
 namespace Athena {
@@ -18,6 +19,9 @@ namespace Entities {
 //----------------------------------------------------------------------------------------
 /// @brief  Represents a list of components
 ///
+/// The components are kept in the order of their addition. An index of them by name
+/// allows to retrieve one of them in constant time.
+///
 /// @remark A list can be associated with an entity or with a scene
 //----------------------------------------------------------------------------------------
 class ATHENA_ENTITIES_SYMBOL ComponentsList
@@ -25,6 +29,19 @@ class ATHENA_ENTITIES_SYMBOL ComponentsList
     friend class ComponentsManager;
 
 
+    //_____ Internal types __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Index of the components by name
+    ///
+    /// The type isn't part of the key: the type of a component is only known once it
+    /// is fully constructed, after its addition to the list. The components sharing a
+    /// name are kept in the order of their addition.
+    //------------------------------------------------------------------------------------
+    typedef std::unordered_map<tSymbol, Component::tComponentsList, tSymbol::tHash>
+                                                                    tComponentsIndex;
+
+
     //_____ Construction / Destruction __________
 public:
     //------------------------------------------------------------------------------------
@@ -98,8 +115,11 @@ private:
 public:
     //------------------------------------------------------------------------------------
     /// @brief  Remove all the components from the list
+    ///
+    /// @param  pKept   A component to keep in the list (0 if none). It is unlinked from
+    ///                 the other components, but not destroyed.
     //------------------------------------------------------------------------------------
-    void removeAllComponents();
+    void removeAllComponents(Component* pKept = 0);
 
     //------------------------------------------------------------------------------------
     /// @brief  Returns one of the components
@@ -148,6 +168,7 @@ private:
     Entity*                     m_pEntity;      ///< The entity associated with this list
     Scene*                      m_pScene;       ///< The scene associated with this list
     Component::tComponentsList  m_components;   ///< The components
+    tComponentsIndex            m_index;        ///< Index of the components by name
 };
 
 }
@@ -8,6 +8,10 @@
 #define _ATHENA_ENTITIES_COMPONENTSMANAGER_H_
 
 #include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/Component.h>
+#include <Athena-Entities/ComponentsPool.h>
+#include <new>
+#include <unordered_map>
 #include <Athena-Core/Utils/Iterators.h>
 #include <Athena-Core/Log/Declarations.h>
 #include <Athena-Core/Log/LogManager.h>
@@ -50,6 +54,9 @@ typedef Component* ComponentCreationMethod(const std::string&, ComponentsList*);
 /// The components are associated with a 'components list', which hold all the components
 /// of an entity (or scene). The destruction of the components is handled by those lists.
 ///
+/// The components of a type can be allocated from a pool (see ComponentsPool) instead of
+/// the heap, to make the creation and destruction of many short-lived components cheap.
+///
 /// @remark This class is a singleton.
 //----------------------------------------------------------------------------------------
 class ATHENA_ENTITIES_SYMBOL ComponentsManager: public Utils::Singleton<ComponentsManager>
@@ -58,10 +65,15 @@ class ATHENA_ENTITIES_SYMBOL ComponentsManager: public Utils::Singleton<Componen
 private:
     struct ComponentCreationInfos
     {
-        virtual ~ComponentCreationInfos() {}
+        ComponentCreationInfos() : typeID(Component::INVALID_TYPE_ID), pPool(0) {}
+        virtual ~ComponentCreationInfos() { delete pPool; }
 
         virtual Component* create(const std::string& strName, ComponentsList* pList) = 0;
 
+        std::string         strType;    ///< The name of the type
+        Component::tTypeID  typeID;     ///< The identifier of the type
+        ComponentsPool*     pPool;      ///< The pool used to allocate the components (0 if none)
+
 #if ATHENA_ENTITIES_SCRIPTING
         virtual v8::Handle<v8::Value> convertToJavaScript(Component* pComponent) = 0;
 #endif
@@ -78,14 +90,30 @@ private:
 #if ATHENA_ENTITIES_SCRIPTING
         virtual v8::Handle<v8::Value> convertToJavaScript(Component* pComponent)
         {
-            return toJavaScript(dynamic_cast<TYPE*>(pComponent));
+            // Only called with components of that type (see getTypeID())
+            return toJavaScript(static_cast<TYPE*>(pComponent));
         }
 #endif
     };
 
-    typedef std::map<std::string, ComponentCreationInfos*>  tCreationsInfosList;
+    template<class TYPE>
+    struct PooledComponentCreationInfos: public TemplatedComponentCreationInfos<TYPE>
+    {
+        PooledComponentCreationInfos(unsigned int nbComponentsPerSlab)
+        {
+            this->pPool = new ComponentsPool(sizeof(TYPE), alignof(TYPE), nbComponentsPerSlab);
+        }
+
+        virtual Component* create(const std::string& strName, ComponentsList* pList)
+        {
+            return new (this->pPool->allocate()) TYPE(strName, pList);
+        }
+    };
+
+    typedef std::unordered_map<std::string, ComponentCreationInfos*> tCreationsInfosList;
     typedef Utils::MapIterator<tCreationsInfosList>         tCreationsInfosIterator;
     typedef tCreationsInfosList::iterator                   tCreationsInfosNativeIterator;
+    typedef std::vector<ComponentCreationInfos*>            tCreationsInfosByID;
 
 
     //_____ Construction / Destruction __________
@@ -126,6 +154,20 @@ public:
     Component* create(const std::string& strType, const std::string& strName,
                       ComponentsList* pList);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Create a new component, without any lookup by the name of its type
+    ///
+    /// To use when creating a lot of components (when loading a level, for instance).
+    ///
+    /// @param  typeID  Identifier of the type of the component (tComponentTypeID<T>::value,
+    ///                 or see getTypeID())
+    /// @param  strName Name of the component
+    /// @param  pList   List to attach the component to
+    /// @return         The new component, 0 if failed
+    //------------------------------------------------------------------------------------
+    Component* create(Component::tTypeID typeID, const std::string& strName,
+                      ComponentsList* pList);
+
     //------------------------------------------------------------------------------------
     /// @brief  Destroy a component
     ///
@@ -151,34 +193,97 @@ public:
     //------------------------------------------------------------------------------------
     /// @brief  Register a new type of component, with a C++ 'component creation method'
     ///
-    /// @param  strType         Name of the type
-    /// @param  pCreationMethod The creation method
+    /// The components are created by T::create().
+    ///
+    /// The type keeps the TYPE_ID of its class if it isn't already used. Otherwise (the
+    /// class doesn't declare its own TYPE_ID, but inherits the one of its parent class), a
+    /// new identifier is assigned to the type, and to the components created by the
+    /// manager, with the one of the parent class as its parent (see component_cast()).
+    /// In both cases, the identifier is stored in tComponentTypeID<T>.
+    ///
+    /// @remark A class must be registered before its subclasses which don't declare
+    ///         their own TYPE_ID
     //------------------------------------------------------------------------------------
     template<class T>
     void registerType()
     {
-        using namespace Athena::Log;
+        Component::tTypeID typeID = registerType(T::TYPE, &T::TYPE_ID,
+                                                 new TemplatedComponentCreationInfos<T>());
+        if (typeID != Component::INVALID_TYPE_ID)
+            tComponentTypeID<T>::value = typeID;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Register a new type of component, whose instances are allocated from a
+    ///         pool
+    ///
+    /// The components are constructed in the memory of the pool by the constructor
+    /// T(const std::string& strName, ComponentsList* pList), instead of T::create().
+    ///
+    /// @param  nbComponentsPerSlab Number of components allocated at once by the pool
+    //------------------------------------------------------------------------------------
+    template<class T>
+    void registerType(unsigned int nbComponentsPerSlab)
+    {
+        Component::tTypeID typeID = registerType(T::TYPE, &T::TYPE_ID,
+                                                 new PooledComponentCreationInfos<T>(nbComponentsPerSlab));
+        if (typeID != Component::INVALID_TYPE_ID)
+            tComponentTypeID<T>::value = typeID;
+    }
 
-        // Declarations
-        tCreationsInfosNativeIterator iter;
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the pool used to allocate the components of a type
+    ///
+    /// Can be used to retrieve statistics about the pool, or to reserve memory for the
+    /// components before their creation.
+    ///
+    /// @param  strType     Name of the type
+    /// @return             The pool, 0 if the type is unknown or doesn't use a pool
+    //------------------------------------------------------------------------------------
+    ComponentsPool* getPool(const std::string& strType);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the identifier of a type of components
+    ///
+    /// @param  strType     Name of the type
+    /// @return             The identifier, Component::INVALID_TYPE_ID if the type is
+    ///                     unknown
+    //------------------------------------------------------------------------------------
+    Component::tTypeID getTypeID(const std::string& strType) const;
 
-        ATHENA_LOG_EVENT2("Components manager", "Registering a new type of component: '" + T::TYPE + "'");
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Register a new type of component
+    ///
+    /// @param  strType     Name of the type
+    /// @param  pTypeID     Address of the TYPE_ID of the class of the components
+    /// @param  pInfos      The creation infos of the type
+    /// @return             The identifier assigned to the type,
+    ///                     Component::INVALID_TYPE_ID if failed
+    //------------------------------------------------------------------------------------
+    Component::tTypeID registerType(const std::string& strType,
+                                    const Component::tTypeID* pTypeID,
+                                    ComponentCreationInfos* pInfos);
 
-        // Search if the type is already defined
-        iter = m_types.find(T::TYPE);
-        if (iter != m_types.end())
-        {
-            ATHENA_LOG_ERROR2("Components manager", "The type of component '" + T::TYPE + "' was already registered");
-            return;
-        }
+    //------------------------------------------------------------------------------------
+    /// @brief  Create a new component of a registered type
+    //------------------------------------------------------------------------------------
+    Component* create(ComponentCreationInfos* pInfos, const std::string& strName,
+                      ComponentsList* pList);
 
-        m_types[T::TYPE] = new TemplatedComponentCreationInfos<T>();
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the creation infos of a type (0 if the type is unknown)
+    //------------------------------------------------------------------------------------
+    inline ComponentCreationInfos* getCreationInfos(Component::tTypeID typeID) const
+    {
+        return (typeID < m_typesByID.size() ? m_typesByID[typeID] : 0);
     }
 
 
     //_____ Attributes __________
 private:
-    tCreationsInfosList m_types;    ///< The registered types
+    tCreationsInfosList m_types;        ///< The registered types
+    tCreationsInfosByID m_typesByID;    ///< The registered types, by identifier
 };
 
 }
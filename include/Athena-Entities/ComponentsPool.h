@@ -0,0 +1,127 @@
+/** @file   ComponentsPool.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::ComponentsPool'
+*/
+
+#ifndef _ATHENA_ENTITIES_COMPONENTSPOOL_H_
+#define _ATHENA_ENTITIES_COMPONENTSPOOL_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Pool of memory blocks used to allocate the components of one type
+///
+/// The memory is allocated by slabs of several blocks, which are never freed before the
+/// destruction of the pool. The released blocks are kept in a free-list and reused by
+/// the next allocations: once the pool has reached its high-water mark, creating and
+/// destroying components doesn't allocate memory anymore.
+///
+/// @remark The pools are used by the components manager (see
+///         ComponentsManager::registerType()). They aren't thread-safe.
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL ComponentsPool
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  size                Size of the objects allocated from the pool
+    /// @param  alignment           Alignment of the objects
+    /// @param  nbObjectsPerSlab    Number of objects in a slab
+    //------------------------------------------------------------------------------------
+    ComponentsPool(size_t size, size_t alignment, unsigned int nbObjectsPerSlab);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    ///
+    /// @remark All the objects must have been released
+    //------------------------------------------------------------------------------------
+    ~ComponentsPool();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns an uninitialized memory block large enough for one object
+    //------------------------------------------------------------------------------------
+    void* allocate();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Gives back a memory block returned by allocate()
+    ///
+    /// The destructor of the object must have been called.
+    //------------------------------------------------------------------------------------
+    void release(void* pObject);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocates the slabs needed to contain at least the given number of objects
+    //------------------------------------------------------------------------------------
+    void reserve(unsigned int nbObjects);
+
+
+    //_____ Statistics __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of objects currently allocated from the pool
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbObjects() const
+    {
+        return m_nbObjects;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of objects that the pool can contain without
+    ///         allocating a new slab
+    //------------------------------------------------------------------------------------
+    inline unsigned int getCapacity() const
+    {
+        return (unsigned int) m_slabs.size() * m_nbObjectsPerSlab;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the maximum number of objects allocated at the same time
+    //------------------------------------------------------------------------------------
+    inline unsigned int getHighWaterMark() const
+    {
+        return m_uiHighWaterMark;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size of the memory blocks
+    //------------------------------------------------------------------------------------
+    inline size_t getBlockSize() const
+    {
+        return m_blockSize;
+    }
+
+
+    //_____ Methods __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocates a new slab, and adds its blocks to the free-list
+    //------------------------------------------------------------------------------------
+    void addSlab();
+
+
+    //_____ Attributes __________
+private:
+    size_t              m_blockSize;        ///< Size of a block (the size of an object, aligned)
+    unsigned int        m_nbObjectsPerSlab;
+    std::vector<char*>  m_slabs;
+    void*               m_pFreeList;        ///< First free block (each one points to the next)
+    unsigned int        m_nbObjects;        ///< See getNbObjects()
+    unsigned int        m_uiHighWaterMark;  ///< See getHighWaterMark()
+};
+
+}
+}
+
+#endif
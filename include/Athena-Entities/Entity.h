@@ -9,6 +9,8 @@
 
 #include <Athena-Entities/Prerequisites.h>
 #include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/tHandle.h>
+#include <Athena-Entities/tBounds.h>
 #include <Athena-Core/Signals/SignalsList.h>
 #include <Athena-Core/Utils/Iterators.h>
 
@@ -54,11 +56,36 @@ protected:
     //------------------------------------------------------------------------------------
     Entity(const std::string& strName, Scene* pScene, Entity* pParent = 0);
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor of an unnamed entity, kept by the scene for a later use
+    ///
+    /// @see    Scene::reserveEntities()
+    //------------------------------------------------------------------------------------
+    Entity(Scene* pScene);
+
     //------------------------------------------------------------------------------------
     /// @brief  Destructor
     //------------------------------------------------------------------------------------
     virtual ~Entity();
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Put the entity back in the state of a newly created one, so the scene can
+    ///         reuse it
+    ///
+    /// Does what the destructor does (the components are destroyed), except for the
+    /// built-in Transforms, which is reset instead. The Transforms releases its slot in
+    /// the store of the scene until the entity is reused (see Transforms::_park()).
+    ///
+    /// @remark The children are only forgotten: the scene recycles them at the same time
+    ///         (see Scene::destroy())
+    //------------------------------------------------------------------------------------
+    void recycle();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Give a new name and parent to a recycled entity
+    //------------------------------------------------------------------------------------
+    void reuse(const std::string& strName, Entity* pParent);
+
 
     //_____ Management of the entity __________
 public:
@@ -72,6 +99,22 @@ public:
     //------------------------------------------------------------------------------------
     inline Scene* getScene() { return m_pScene; }
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the handle of the entity in its scene
+    ///
+    /// @remark The handle changes when the entity is transfered to another scene
+    /// @see    Scene::getEntity(const tHandle&)
+    //------------------------------------------------------------------------------------
+    inline const tHandle& getHandle() const { return m_handle; }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the entity is being destroyed at the same time as others
+    ///
+    /// The links between the components of those entities aren't maintained during
+    /// their destruction.
+    //------------------------------------------------------------------------------------
+    inline bool _isBeingDestroyed() const { return m_bBeingDestroyed; }
+
     //------------------------------------------------------------------------------------
     /// @brief  Enable/Disable the entity
     ///
@@ -217,7 +260,10 @@ public:
     //------------------------------------------------------------------------------------
     inline Signals::SignalsList* getSignalsList()
     {
-        return &m_signals;
+        if (!m_pSignals)
+            m_pSignals = new Signals::SignalsList();
+
+        return m_pSignals;
     }
 
 
@@ -232,6 +278,32 @@ public:
     }
 
 
+    //_____ Management of the bounds __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the bounds of the entity, in the local space of its transforms
+    ///
+    /// The entities having bounds are put in the bounds hierarchy of their scene, used
+    /// by the ray casts and the frustum culling (see Scene::castRay())
+    //------------------------------------------------------------------------------------
+    void setBounds(const tBounds& bounds);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Removes the bounds of the entity
+    //------------------------------------------------------------------------------------
+    void removeBounds();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the entity has bounds
+    //------------------------------------------------------------------------------------
+    inline bool hasBounds() const { return m_bHasBounds; }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the bounds of the entity, in the local space of its transforms
+    //------------------------------------------------------------------------------------
+    inline const tBounds& getBounds() const { return m_bounds; }
+
+
     //_____ Management of the animations __________
 public:
     //------------------------------------------------------------------------------------
@@ -254,16 +326,27 @@ public:
 protected:
     std::string             m_strName;          ///< Name
     Scene*                  m_pScene;           ///< The scene managing the entity
+    tHandle                 m_handle;           ///< Handle of the entity in its scene
+    unsigned int            m_uiIndex;          ///< Index of the entity in its scene
     bool                    m_bEnabled;         ///< Indicates if the entity is enabled
+    bool                    m_bBeingDestroyed;  ///< See _isBeingDestroyed()
                                                 ///  used by this entity
     ComponentsList          m_components;       ///< The list of components
-    Signals::SignalsList    m_signals;          ///< The signals list
+    Signals::SignalsList*   m_pSignals;         ///< The signals list (0 until needed)
     AnimationsMixer*        m_pAnimationsMixer; ///< The animations mixer
     Transforms*             m_pTransforms;      ///< The transforms
+    tBounds                 m_bounds;           ///< The bounds (in local space)
+    bool                    m_bHasBounds;       ///< Indicates if the entity has bounds
 
     // Parent/children relations
     Entity*                 m_pParent;          ///< Parent of this entity
     tEntitiesList           m_children;         ///< Children of the entity
+
+    // Archetypes (see Scene::enableArchetypes())
+    Archetype*              m_pArchetype;       ///< The archetype containing the entity (if any)
+    unsigned int            m_uiArchetypeIndex; ///< Index of the entity in its archetype
+    bool                    m_bUnclassified;    ///< Indicates if the entity is in the list of
+                                                ///  the entities to put in an archetype
 };
 
 }
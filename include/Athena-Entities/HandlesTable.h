@@ -0,0 +1,111 @@
+/** @file   HandlesTable.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::HandlesTable'
+*/
+
+#ifndef _ATHENA_ENTITIES_HANDLESTABLE_H_
+#define _ATHENA_ENTITIES_HANDLESTABLE_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/tHandle.h>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Table of slots used to resolve handles to objects in constant time
+///
+/// The released slots are reused by the next allocations, with a new generation: the
+/// handles to the previous object of the slot don't resolve anymore.
+///
+/// @remark Used by the scenes, for their entities and their components (see tHandle)
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL HandlesTable
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    HandlesTable();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~HandlesTable();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocates a slot for an object
+    ///
+    /// @param  pObject     The object
+    /// @return             The handle of the object
+    //------------------------------------------------------------------------------------
+    tHandle allocate(void* pObject);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Releases the slot of an object, the handle doesn't resolve anymore
+    ///
+    /// @param  handle      The handle of the object
+    //------------------------------------------------------------------------------------
+    void release(const tHandle& handle);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Preallocate the memory needed by a number of objects, so their allocation
+    ///         doesn't allocate memory
+    ///
+    /// @param  nbObjects   The total number of objects
+    //------------------------------------------------------------------------------------
+    void reserve(unsigned int nbObjects);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the object referenced by a handle
+    ///
+    /// @param  handle      The handle
+    /// @return             The object, 0 if it was released
+    //------------------------------------------------------------------------------------
+    inline void* get(const tHandle& handle) const
+    {
+        if ((handle.uiIndex < m_slots.size()) &&
+            (m_slots[handle.uiIndex].uiGeneration == handle.uiGeneration))
+        {
+            return m_slots[handle.uiIndex].pObject;
+        }
+
+        return 0;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of objects in the table
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbObjects() const
+    {
+        return (unsigned int) (m_slots.size() - m_freeSlots.size());
+    }
+
+
+    //_____ Internal types __________
+private:
+    struct tSlot
+    {
+        void*           pObject;        ///< The object, 0 if the slot is free
+        unsigned int    uiGeneration;   ///< The generation of the slot (never 0)
+    };
+
+
+    //_____ Attributes __________
+private:
+    std::vector<tSlot>          m_slots;
+    std::vector<unsigned int>   m_freeSlots;    ///< The slots available for reuse
+};
+
+}
+}
+
+#endif
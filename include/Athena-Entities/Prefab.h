@@ -0,0 +1,164 @@
+/** @file   Prefab.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::Prefab'
+*/
+
+#ifndef _ATHENA_ENTITIES_PREFAB_H_
+#define _ATHENA_ENTITIES_PREFAB_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/Component.h>
+#include <Athena-Entities/tBounds.h>
+#include <Athena-Core/Utils/Variant.h>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Template of an entity (with its children), compiled once and instantiated
+///         several times
+///
+/// The prefab keeps, for each entity of the hierarchy, the types and the properties of
+/// its components, and the links between them and the Transforms components of the
+/// hierarchy. An instantiation directly creates the components by type identifier and
+/// applies copies of the properties, without parsing any JSON nor looking up the types
+/// by name.
+///
+/// The root of an instance gets the name given to instantiate(), and the other entities
+/// are named '<name>.<name of the entity in the prefab>', so several instances can live
+/// in the same scene.
+///
+/// @remark Only the links to the Transforms components of the hierarchy are remapped to
+///         the ones of the instance: the links to components outside the hierarchy are
+///         reset (see Component::setTransforms()), and the other properties referencing
+///         components by ID are copied as-is
+/// @see    fromJSON(const rapidjson::Value&, Prefab*) to compile a prefab from JSON
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL Prefab
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor of an empty prefab
+    //------------------------------------------------------------------------------------
+    Prefab();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  pEntity     The entity to compile (see compile())
+    //------------------------------------------------------------------------------------
+    Prefab(Entity* pEntity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~Prefab();
+
+private:
+    Prefab(const Prefab&);
+    Prefab& operator=(const Prefab&);
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Compiles the prefab from an entity and its children (the previous content
+    ///         of the prefab is discarded)
+    ///
+    /// The entity isn't modified, and isn't referenced by the prefab afterwards.
+    //------------------------------------------------------------------------------------
+    void compile(Entity* pEntity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Discards the content of the prefab
+    //------------------------------------------------------------------------------------
+    void clear();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the prefab is empty
+    //------------------------------------------------------------------------------------
+    inline bool isEmpty() const
+    {
+        return m_entities.empty();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of entities created by an instantiation
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbEntities() const
+    {
+        return (unsigned int) m_entities.size();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of components created by an instantiation (including
+    ///         the Transforms components of the entities)
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbComponents() const
+    {
+        return (unsigned int) m_components.size();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Creates a new instance of the prefab
+    ///
+    /// @param  strName     Name of the root entity of the instance
+    /// @param  pScene      The scene in which the entities are created
+    /// @param  pParent     Parent of the root entity, 0 if none
+    /// @return             The root entity of the instance
+    //------------------------------------------------------------------------------------
+    Entity* instantiate(const std::string& strName, Scene* pScene, Entity* pParent = 0) const;
+
+
+    //_____ Internal types __________
+private:
+    struct tProperty
+    {
+        std::string     strCategory;
+        std::string     strName;
+        Utils::Variant* pValue;
+    };
+
+    struct tComponent
+    {
+        Component::tTypeID  typeID;
+        std::string         strName;
+        unsigned int        transforms;     ///< Linked Transforms component (NO_LINK if none)
+        unsigned int        firstProperty;
+        unsigned int        nbProperties;
+    };
+
+    struct tEntity
+    {
+        std::string     strName;
+        unsigned int    parent;             ///< Parent entity (NO_LINK for the root)
+        unsigned int    firstComponent;     ///< Index of the Transforms of the entity, its
+                                            ///  other components follow
+        unsigned int    nbComponents;
+        bool            bEnabled;
+        bool            bHasBounds;
+        tBounds         bounds;
+    };
+
+
+    //_____ Constants __________
+private:
+    static const unsigned int NO_LINK = 0xFFFFFFFF;
+
+
+    //_____ Attributes __________
+private:
+    std::vector<tEntity>    m_entities;     ///< The entities, each one after its parent
+    std::vector<tComponent> m_components;
+    std::vector<tProperty>  m_properties;
+};
+
+}
+}
+
+#endif
@@ -36,14 +36,22 @@ namespace Athena
     {
         class Animation;
         class AnimationsMixer;
+        class Archetype;
+        class BoundsHierarchy;
         class Component;
         class ComponentAnimation;
         class ComponentsList;
         class ComponentsManager;
+        class ComponentsPool;
         class Entity;
+        class Prefab;
         class Scene;
         class ScenesManager;
+        class SpatialIndex;
         class Transforms;
+        class TransformsBatch;
+        class TransformsStore;
+        class WorkersPool;
 
         typedef unsigned int tAnimation;
 
@@ -10,8 +10,15 @@
 #include <Athena-Entities/Prerequisites.h>
 #include <Athena-Entities/Entity.h>
 #include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/TransformsStore.h>
+#include <Athena-Entities/HandlesTable.h>
+#include <Athena-Entities/Archetype.h>
+#include <Athena-Entities/SpatialIndex.h>
+#include <Athena-Entities/BoundsHierarchy.h>
 #include <Athena-Core/Signals/SignalsList.h>
 #include <Athena-Core/Utils/Iterators.h>
+#include <map>
+#include <unordered_map>
 
 
 namespace Athena {
@@ -25,6 +32,12 @@ namespace Entities {
 //----------------------------------------------------------------------------------------
 class ATHENA_ENTITIES_SYMBOL Scene
 {
+    //_____ Internal types __________
+public:
+    typedef std::vector<Archetype*>                 tArchetypesList;
+    typedef Utils::VectorIterator<tArchetypesList>  tArchetypesIterator;
+
+
     //_____ Construction / Destruction __________
 public:
     //------------------------------------------------------------------------------------
@@ -114,6 +127,9 @@ public:
     ///
     /// @param  uiIndex     The index of the entity
     /// @return             The entity
+    ///
+    /// @remark When an entity is destroyed or transferred, the last entity of the scene
+    ///         takes its index
     //------------------------------------------------------------------------------------
     inline Entity* getEntity(unsigned int uiIndex) const
     {
@@ -121,25 +137,65 @@ public:
         return m_entities[uiIndex];
     }
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns an entity
+    ///
+    /// @param  handle      The handle of the entity (see Entity::getHandle())
+    /// @return             The entity, 0 if it was destroyed or isn't in the scene anymore
+    //------------------------------------------------------------------------------------
+    inline Entity* getEntity(const tHandle& handle) const
+    {
+        return static_cast<Entity*>(m_entitiesHandles.get(handle));
+    }
+
     //------------------------------------------------------------------------------------
     /// @brief  Destroy an entity
     ///
     /// @param  strName     Name of the entity
+    ///
+    /// @remark See destroy(Entity*)
     //------------------------------------------------------------------------------------
     void destroy(const std::string& strName);
 
     //------------------------------------------------------------------------------------
     /// @brief  Destroy an entity
     ///
+    /// The children of the entity (and all their children) are destroyed at the same
+    /// time. The 'component destroyed' signals of their components are fired, but the
+    /// links between those components are just released: the components aren't asked
+    /// to unlink each other (see Component::mustUnlinkComponent()).
+    ///
     /// @param  pEntity     The entity
     //------------------------------------------------------------------------------------
     void destroy(Entity* pEntity);
 
     //------------------------------------------------------------------------------------
     /// @brief  Destroy all the entities
+    ///
+    /// All the entities are destroyed at the same time (see destroy(Entity*)).
     //------------------------------------------------------------------------------------
     void destroyAll();
 
+    //------------------------------------------------------------------------------------
+    /// @brief  Preallocate some entities, so their creation doesn't allocate memory
+    ///
+    /// The destroyed entities aren't deleted, but kept by the scene and reused by the
+    /// next calls to create(). This method makes sure that at least the given number of
+    /// entities are available that way, and reserves the memory needed by their
+    /// handles and their transforms.
+    ///
+    /// @param  nbEntities  The number of entities
+    //------------------------------------------------------------------------------------
+    void reserveEntities(unsigned int nbEntities);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of entities kept for a later use by create()
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbFreeEntities() const
+    {
+        return (unsigned int) m_freeEntities.size();
+    }
+
     //------------------------------------------------------------------------------------
     /// @brief  Transfer an entity from another scene into this one
     ///
@@ -259,6 +315,391 @@ public:
     }
 
 
+    //_____ Components by type __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns an iterator over all the components of a type in the scene (the
+    ///         ones of the scene and the ones of its entities)
+    ///
+    /// @param  strType     The type of the components (see Component::getType())
+    ///
+    /// @remark The iterator is invalidated by the destruction of a component of that
+    ///         type (the last component of the type takes the place of the destroyed
+    ///         one). The components created meanwhile aren't part of the iteration.
+    //------------------------------------------------------------------------------------
+    Component::tComponentsIterator getComponentsIterator(const std::string& strType);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of components of a type in the scene
+    ///
+    /// @param  strType     The type of the components (see Component::getType())
+    //------------------------------------------------------------------------------------
+    unsigned int getNbComponents(const std::string& strType);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns one of the components of the scene or of its entities
+    ///
+    /// @param  handle      The handle of the component (see Component::getHandle())
+    /// @return             The component, 0 if it was destroyed or isn't in the scene
+    ///                     anymore
+    //------------------------------------------------------------------------------------
+    inline Component* getComponent(const tHandle& handle) const
+    {
+        return static_cast<Component*>(m_componentsHandles.get(handle));
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Calls a functor on all the components of a type in the scene
+    ///
+    /// The type is given by the class of the components (TYPE::TYPE), and the functor is
+    /// called with a 'TYPE*'. Only the components of that exact type are visited, not the
+    /// ones of its subclasses.
+    ///
+    /// @param  functor     The functor
+    /// @return             The functor, after the iteration
+    ///
+    /// @remark The functor must not destroy components of that type
+    //------------------------------------------------------------------------------------
+    template<class TYPE, class FUNCTOR>
+    FUNCTOR forEachComponent(FUNCTOR functor)
+    {
+        const Component::tComponentsList& components = getComponentsOfType(TYPE::TYPE);
+
+        for (unsigned int i = 0; i < components.size(); ++i)
+            functor(static_cast<TYPE*>(components[i]));
+
+        return functor;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Called by the components lists of the scene when a component is added to
+    ///         them
+    //------------------------------------------------------------------------------------
+    void _registerComponent(Component* pComponent);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Called by the components lists of the scene when a component is removed
+    ///         from them
+    //------------------------------------------------------------------------------------
+    void _unregisterComponent(Component* pComponent);
+
+
+    //_____ Archetypes __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable/Disable the grouping of the entities by archetype
+    ///
+    /// When enabled, the entities having the same set of types of components are grouped
+    /// into an archetype, which references them (and their components) in chunks that
+    /// can be iterated linearly (see Archetype). The components themselves aren't moved:
+    /// the entities and their components lists keep working as usual.
+    ///
+    /// @remark Disabled by default, since each addition or removal of a component then
+    ///         moves its entity into another archetype
+    //------------------------------------------------------------------------------------
+    void enableArchetypes(bool bEnabled = true);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the entities are grouped by archetype
+    //------------------------------------------------------------------------------------
+    inline bool areArchetypesEnabled() const
+    {
+        return m_bArchetypesEnabled;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns an iterator over the archetypes of the scene
+    ///
+    /// @remark The iterator is invalidated by the creation of a new archetype (when an
+    ///         entity with a new set of types of components is processed)
+    //------------------------------------------------------------------------------------
+    tArchetypesIterator getArchetypesIterator();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of archetypes of the scene
+    //------------------------------------------------------------------------------------
+    unsigned int getNbArchetypes();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the archetype containing an entity
+    ///
+    /// @return The archetype, 0 if the archetypes are disabled
+    //------------------------------------------------------------------------------------
+    Archetype* getArchetype(Entity* pEntity);
+
+
+    //_____ Spatial index __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable/Disable the index of the entities by world position
+    ///
+    /// When enabled, the entities are put in a spatial index (see SpatialIndex), and the
+    /// ones having bounds (see Entity::setBounds()) in a bounds hierarchy (see
+    /// BoundsHierarchy). Both are updated before each query with the entities whose
+    /// world transforms or bounds changed since the previous one (the store of the scene
+    /// tracks them, see TransformsStore::setChangesTracked()).
+    ///
+    /// @param  bEnabled    Indicates if the index must be enabled
+    /// @param  cellSize    Size of the cells of the index
+    ///
+    /// @remark Disabled by default
+    //------------------------------------------------------------------------------------
+    void enableSpatialIndex(bool bEnabled = true, Math::Real cellSize = 10.0f);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the entities are indexed by world position
+    //------------------------------------------------------------------------------------
+    inline bool isSpatialIndexEnabled() const
+    {
+        return (m_pSpatialIndex != 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the spatial index, up-to-date (0 if disabled)
+    ///
+    /// @remark The index isn't updated by the modifications of the transforms done
+    ///         after this call
+    //------------------------------------------------------------------------------------
+    SpatialIndex* getSpatialIndex();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities located in a sphere (the spatial index must be
+    ///         enabled)
+    ///
+    /// @see    SpatialIndex::getEntitiesInRadius()
+    //------------------------------------------------------------------------------------
+    void getEntitiesInRadius(const Math::Vector3& center, Math::Real radius,
+                             Entity::tEntitiesList& entities);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities located in an axis-aligned box (the spatial index
+    ///         must be enabled)
+    ///
+    /// @see    SpatialIndex::getEntitiesInBox()
+    //------------------------------------------------------------------------------------
+    void getEntitiesInBox(const Math::Vector3& min, const Math::Vector3& max,
+                          Entity::tEntitiesList& entities);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities nearest to a point (the spatial index must be
+    ///         enabled)
+    ///
+    /// @see    SpatialIndex::getNearestEntities()
+    //------------------------------------------------------------------------------------
+    void getNearestEntities(const Math::Vector3& point, unsigned int nbEntities,
+                            Entity::tEntitiesList& entities);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the bounds hierarchy, up-to-date (0 if the spatial index is
+    ///         disabled)
+    ///
+    /// @remark The hierarchy isn't updated by the modifications of the transforms or of
+    ///         the bounds done after this call
+    //------------------------------------------------------------------------------------
+    BoundsHierarchy* getBoundsHierarchy();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities whose bounds are hit by a ray (the spatial index
+    ///         must be enabled)
+    ///
+    /// @see    BoundsHierarchy::castRay()
+    //------------------------------------------------------------------------------------
+    unsigned int castRay(const Math::Vector3& origin, const Math::Vector3& direction,
+                         Math::Real maxDistance, BoundsHierarchy::tRayHit* pHits,
+                         unsigned int maxHits);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities whose bounds are inside a frustum (the spatial
+    ///         index must be enabled)
+    ///
+    /// @see    BoundsHierarchy::getEntitiesInFrustum()
+    //------------------------------------------------------------------------------------
+    unsigned int getEntitiesInFrustum(const tFrustum& frustum, Entity** pEntities,
+                                      unsigned int maxEntities);
+
+
+    //_____ Management of the transforms __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the store containing the data of all the Transforms components of
+    ///         the scene
+    //------------------------------------------------------------------------------------
+    inline TransformsStore* getTransformsStore()
+    {
+        return &m_transformsStore;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of all the Transforms components of the scene
+    ///         that need it
+    ///
+    /// This is done in one pass over the TransformsStore of the scene (parents before
+    /// children), which is a lot faster than letting each component compute its world
+    /// transforms on demand. Call it once per frame, before the subsystems (rendering,
+    /// physics, ...) retrieve the world transforms of the entities.
+    //------------------------------------------------------------------------------------
+    inline void updateTransforms()
+    {
+        m_transformsStore.update();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the number of threads used by updateTransforms()
+    ///
+    /// The root entities of the scene have independent hierarchies, which can be
+    /// processed in parallel. The results are identical to the ones obtained with only
+    /// one thread.
+    ///
+    /// @param  nbThreads   The number of threads, including the calling one (0: the
+    ///                     number of hardware threads, 1: no worker thread, the default)
+    //------------------------------------------------------------------------------------
+    inline void setNbTransformsThreads(unsigned int nbThreads)
+    {
+        m_transformsStore.setNbThreads(nbThreads);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of threads used by updateTransforms()
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbTransformsThreads() const
+    {
+        return m_transformsStore.getNbThreads();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable or disable the snapshots of the world transforms of the entities,
+    ///         used to interpolate between two frames
+    ///
+    /// @see    commitFrame(), Transforms::getInterpolatedWorldTransforms()
+    //------------------------------------------------------------------------------------
+    inline void setTransformsInterpolationEnabled(bool bEnabled)
+    {
+        m_transformsStore.setInterpolationEnabled(bEnabled);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the snapshots of the world transforms of the entities are
+    ///         enabled
+    //------------------------------------------------------------------------------------
+    inline bool isTransformsInterpolationEnabled() const
+    {
+        return m_transformsStore.isInterpolationEnabled();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Marks the end of a frame (typically a fixed-rate simulation step)
+    ///
+    /// The world transforms of the entities are updated (see updateTransforms()) and,
+    /// if enabled, a snapshot of them is taken. The renderer can then interpolate
+    /// between the two last frames using Transforms::getInterpolatedWorldTransforms().
+    //------------------------------------------------------------------------------------
+    inline void commitFrame()
+    {
+        m_transformsStore.commitFrame();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the frame counter of the scene (incremented by commitFrame(),
+    ///         starts at 1)
+    //------------------------------------------------------------------------------------
+    inline unsigned int getFrame() const
+    {
+        return m_transformsStore.getFrame();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Writes the world matrices of the entities of the scene in a buffer
+    ///
+    /// The world transforms are updated first (see updateTransforms()). Each matrix is
+    /// written as 16 floats (row-major, like Math::Matrix4), in the order of the entities
+    /// in the scene (see getEntity()), which only changes when entities are destroyed
+    /// or transferred.
+    ///
+    /// When an entity is removed from the scene, the last one is moved at its index: the
+    /// world transforms of the moved entity are then considered as changed during the
+    /// current frame, so a consumer only using the matrices written since a frame gets
+    /// its matrix at its new index.
+    ///
+    /// @param  pBuffer         The buffer, which must be large enough to contain
+    ///                         getNbEntities() matrices (16 * getNbEntities() floats)
+    /// @param  uiSinceFrame    If not 0, only the matrices of the entities whose world
+    ///                         transforms were computed during this frame or after are
+    ///                         written (see getFrame())
+    /// @param  pIndices        If not 0, receives the index of the entity of each written
+    ///                         matrix (must be large enough to contain getNbEntities()
+    ///                         indices)
+    /// @return                 The number of matrices written
+    //------------------------------------------------------------------------------------
+    unsigned int exportWorldMatrices(float* pBuffer, unsigned int uiSinceFrame = 0,
+                                     unsigned int* pIndices = 0);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Writes the world matrices of some entities of the scene in a buffer
+    ///
+    /// Same as above, but for the given list of entities only. The indices written in
+    /// pIndices are positions in that list.
+    ///
+    /// @param  entities        The entities (must belong to the scene)
+    /// @param  pBuffer         The buffer, which must be large enough to contain
+    ///                         entities.size() matrices
+    /// @param  uiSinceFrame    If not 0, only the matrices of the entities whose world
+    ///                         transforms were computed during this frame or after are
+    ///                         written
+    /// @param  pIndices        If not 0, receives the position in the list of the entity
+    ///                         of each written matrix
+    /// @return                 The number of matrices written
+    //------------------------------------------------------------------------------------
+    unsigned int exportWorldMatrices(const Entity::tEntitiesList& entities, float* pBuffer,
+                                     unsigned int uiSinceFrame = 0,
+                                     unsigned int* pIndices = 0);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Starts a batch of modifications of the transforms of the entities
+    ///
+    /// @see    TransformsStore::beginBatch(), TransformsBatch
+    //------------------------------------------------------------------------------------
+    inline void beginTransformsBatch()
+    {
+        m_transformsStore.beginBatch();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Ends a batch of modifications of the transforms of the entities
+    ///
+    /// @see    TransformsStore::endBatch(), TransformsBatch
+    //------------------------------------------------------------------------------------
+    inline void endTransformsBatch()
+    {
+        m_transformsStore.endBatch();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the absolute position of the origin of the world transforms of
+    ///         the scene
+    ///
+    /// @see    rebaseOrigin(), Transforms::getAbsoluteWorldPosition()
+    //------------------------------------------------------------------------------------
+    inline const tAbsolutePosition& getOrigin() const
+    {
+        return m_transformsStore.getOrigin();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Moves the origin of the world transforms of the scene
+    ///
+    /// Used in large worlds to keep the world transforms of the entities close to the
+    /// camera in the range where Math::Real is precise enough. All the entities keep
+    /// their absolute position: their world positions are shifted by -offset.
+    ///
+    /// The Transforms of the scene are updated in one pass (see
+    /// TransformsStore::rebaseOrigin()) and aren't notified individually: the
+    /// SIGNAL_SCENE_ORIGIN_CHANGED signal is fired once instead.
+    ///
+    /// @param  offset  Position of the new origin, in the current world space
+    //------------------------------------------------------------------------------------
+    void rebaseOrigin(const Math::Vector3& offset);
+
+
     //_____ Management of the signals list __________
 public:
     //------------------------------------------------------------------------------------
@@ -270,13 +711,89 @@ public:
     }
 
 
+    //_____ Methods __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Remove an entity and its children from the scene, and keep them for a
+    ///         later use
+    //------------------------------------------------------------------------------------
+    void recycle(Entity* pEntity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Remove some entities from the scene, and keep them for a later use
+    ///
+    /// @param  entities    The entities, which must include all their children
+    //------------------------------------------------------------------------------------
+    void recycle(const Entity::tEntitiesList& entities);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Add an entity in the list and the index of the entities of the scene
+    //------------------------------------------------------------------------------------
+    void addEntity(Entity* pEntity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Remove an entity from the list and the index of the entities of the scene
+    ///
+    /// The last entity of the list takes its place.
+    //------------------------------------------------------------------------------------
+    void removeEntity(Entity* pEntity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the list of the components of a type in the scene
+    //------------------------------------------------------------------------------------
+    Component::tComponentsList& getComponentsOfType(const std::string& strType);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Remove an entity from its archetype, it will be put in another one later
+    ///         (when its components have changed)
+    //------------------------------------------------------------------------------------
+    void declassify(Entity* pEntity);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Put the entities whose components have changed in their archetype
+    //------------------------------------------------------------------------------------
+    void classifyEntities();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destroy all the archetypes
+    //------------------------------------------------------------------------------------
+    void destroyArchetypes();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Update the spatial index and the bounds hierarchy with the entities whose
+    ///         world transforms or bounds changed
+    //------------------------------------------------------------------------------------
+    void refreshSpatialIndex();
+
+
+    //_____ Internal types __________
+private:
+    typedef std::map<std::string, Component::tComponentsList> tComponentsByType;
+    typedef std::map<Archetype::tSignature, Archetype*>       tArchetypesBySignature;
+    typedef std::unordered_map<std::string, Entity*>          tEntitiesByName;
+
+
     //_____ Attributes __________
 protected:
     std::string             m_strName;              ///< Name of the scene
     bool                    m_bEnabled;             ///< Indicates if the scene is enabled
     bool                    m_bShown;               ///< Indicates if the scene is shown
     Signals::SignalsList    m_signals;              ///< The signals list
+    TransformsStore         m_transformsStore;      ///< The data of the Transforms components
     Entity::tEntitiesList   m_entities;             ///< The list of entities of the scene
+    tEntitiesByName         m_entitiesByName;       ///< Index of the entities by name
+    Entity::tEntitiesList   m_freeEntities;         ///< The recycled entities
+    HandlesTable            m_entitiesHandles;      ///< The handles of the entities
+    HandlesTable            m_componentsHandles;    ///< The handles of the components
+    tComponentsByType       m_componentsByType;     ///< All the components, by type
+    Component::tComponentsList m_newComponents;     ///< The components not sorted by type yet
+    bool                    m_bArchetypesEnabled;   ///< Indicates if the entities are grouped by archetype
+    tArchetypesList         m_archetypes;           ///< The archetypes
+    tArchetypesBySignature  m_archetypesBySignature;///< The archetypes, by signature
+    Entity::tEntitiesList   m_unclassifiedEntities; ///< The entities to put in an archetype
+    SpatialIndex*           m_pSpatialIndex;        ///< The spatial index (0 if disabled)
+    BoundsHierarchy*        m_pBoundsHierarchy;     ///< The bounds hierarchy (0 if disabled)
+    std::vector<TransformsStore::tIndex> m_changedSlots; ///< Used to update the spatial index
     ComponentsList          m_components;           ///< The list of components
     Component*              m_mainComponents[3];    ///< Main visual, physical and audio components
 };
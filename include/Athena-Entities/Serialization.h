@@ -118,6 +118,31 @@ namespace Entities {
                                                       Utils::PropertiesList* pCombinedDelayedProperties = 0);
 
 
+    //------------------------------------------------------------------------------------
+    /// @brief Compiles a prefab from the rapidjson representation of an entity
+    ///
+    /// The JSON representation is only parsed once: the entities are created in a
+    /// temporary scene, compiled, then destroyed.
+    ///
+    /// @param  json_entity     The rapidjson value
+    /// @retval pPrefab         The prefab to compile
+    /// @return                 'true' if successful
+    //------------------------------------------------------------------------------------
+    ATHENA_ENTITIES_SYMBOL bool fromJSON(const rapidjson::Value& json_entity,
+                                         Entities::Prefab* pPrefab);
+
+
+    //------------------------------------------------------------------------------------
+    /// @brief Compiles a prefab from the JSON representation of an entity, as a string
+    ///
+    /// @param  json_entity     The JSON string
+    /// @retval pPrefab         The prefab to compile
+    /// @return                 'true' if successful
+    //------------------------------------------------------------------------------------
+    ATHENA_ENTITIES_SYMBOL bool fromJSON(const std::string& json_entity,
+                                         Entities::Prefab* pPrefab);
+
+
     //------------------------------------------------------------------------------------
     /// @brief Returns the rapidjson representation of a scene
     ///
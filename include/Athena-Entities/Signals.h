@@ -20,6 +20,7 @@ enum tSignals
     SIGNAL_SCENE_DISABLED,                              ///< Fired when a scene is disabled
     SIGNAL_SCENE_SHOWN,                                 ///< Fired when a scene is shown
     SIGNAL_SCENE_HIDDEN,                                ///< Fired when a scene is hidden
+    SIGNAL_SCENE_ORIGIN_CHANGED,                        ///< Fired when the origin of a scene is moved
 
     // Entities
     SIGNAL_ENTITY_ENABLED,                              ///< Fired when an entity is enabled
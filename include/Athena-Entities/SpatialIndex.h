@@ -0,0 +1,194 @@
+/** @file   SpatialIndex.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::SpatialIndex'
+*/
+
+#ifndef _ATHENA_ENTITIES_SPATIALINDEX_H_
+#define _ATHENA_ENTITIES_SPATIALINDEX_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/Entity.h>
+#include <Athena-Math/Vector3.h>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Index of the entities of a scene by world position
+///
+/// The space is divided into cubic cells of a fixed size, only the cells containing
+/// entities are stored (in a hash map). A query only looks at the entities of the cells
+/// overlapping the searched region.
+///
+/// The positions are the world positions of the entities, relative to the origin of
+/// their scene (see Scene::rebaseOrigin()).
+///
+/// @remark The index is maintained by the scene (see Scene::enableSpatialIndex()), which
+///         updates it before each query with the entities that moved since the previous
+///         one
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL SpatialIndex
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  cellSize    Size of the cells (ideally, the typical radius of the queries)
+    //------------------------------------------------------------------------------------
+    SpatialIndex(Math::Real cellSize);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~SpatialIndex();
+
+
+    //_____ Queries __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities located in a sphere
+    ///
+    /// @param  center      Center of the sphere
+    /// @param  radius      Radius of the sphere
+    /// @param  entities    The entities are added to this list (in no particular order)
+    //------------------------------------------------------------------------------------
+    void getEntitiesInRadius(const Math::Vector3& center, Math::Real radius,
+                             Entity::tEntitiesList& entities) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities located in an axis-aligned box
+    ///
+    /// @param  min         Minimum corner of the box
+    /// @param  max         Maximum corner of the box
+    /// @param  entities    The entities are added to this list (in no particular order)
+    //------------------------------------------------------------------------------------
+    void getEntitiesInBox(const Math::Vector3& min, const Math::Vector3& max,
+                          Entity::tEntitiesList& entities) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the entities nearest to a point
+    ///
+    /// @param  point       The point
+    /// @param  nbEntities  The maximum number of entities to retrieve
+    /// @param  entities    The entities are added to this list, from the nearest one
+    //------------------------------------------------------------------------------------
+    void getNearestEntities(const Math::Vector3& point, unsigned int nbEntities,
+                            Entity::tEntitiesList& entities) const;
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the size of the cells
+    //------------------------------------------------------------------------------------
+    inline Math::Real getCellSize() const
+    {
+        return m_cellSize;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of entities in the index
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbEntities() const
+    {
+        return m_nbEntities;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of cells containing entities
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbCells() const
+    {
+        return (unsigned int) m_cells.size();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if an entity is in the index
+    //------------------------------------------------------------------------------------
+    bool contains(Entity* pEntity) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Adds an entity in the index, or updates its position
+    ///
+    /// @remark The entries are indexed by the handles of the entities: they must belong
+    ///         to the same scene
+    //------------------------------------------------------------------------------------
+    void _update(Entity* pEntity, const Math::Vector3& position);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Removes an entity from the index (if it is in it)
+    //------------------------------------------------------------------------------------
+    void _remove(Entity* pEntity);
+
+
+    //_____ Internal types __________
+private:
+    struct tCell
+    {
+        int x, y, z;
+
+        inline bool operator==(const tCell& cell) const
+        {
+            return (x == cell.x) && (y == cell.y) && (z == cell.z);
+        }
+    };
+
+    struct tCellHash
+    {
+        inline size_t operator()(const tCell& cell) const
+        {
+            return ((size_t) cell.x * 73856093u) ^ ((size_t) cell.y * 19349663u) ^
+                   ((size_t) cell.z * 83492791u);
+        }
+    };
+
+    struct tEntry
+    {
+        Entity*         pEntity;        ///< The entity (0 if the entry isn't used)
+        Math::Vector3   position;       ///< World position of the entity
+        tCell           cell;           ///< Cell containing the entity
+        unsigned int    uiIndexInCell;  ///< Index of the entry in the list of the cell
+    };
+
+    /// Indices of the entries of each non-empty cell
+    typedef std::unordered_map<tCell, std::vector<unsigned int>, tCellHash> tCellsMap;
+
+    typedef std::vector<const std::vector<unsigned int>*> tCellsList;
+
+
+    //_____ Methods __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the cell containing a position
+    //------------------------------------------------------------------------------------
+    tCell getCell(const Math::Vector3& position) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the non-empty cells between two cells (included)
+    //------------------------------------------------------------------------------------
+    void getCells(const tCell& min, const tCell& max, tCellsList& cells) const;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Removes an entry from the list of its cell
+    //------------------------------------------------------------------------------------
+    void removeFromCell(unsigned int entry);
+
+
+    //_____ Attributes __________
+private:
+    Math::Real          m_cellSize;
+    tCellsMap           m_cells;
+    std::vector<tEntry> m_entries;      ///< The entries, indexed by the handles of the entities
+    unsigned int        m_nbEntities;
+};
+
+}
+}
+
+#endif
@@ -13,8 +13,10 @@
 #include <Athena-Entities/Prerequisites.h>
 #include <Athena-Entities/Component.h>
 #include <Athena-Entities/Entity.h>
+#include <Athena-Entities/TransformsStore.h>
 #include <Athena-Math/Vector3.h>
 #include <Athena-Math/Quaternion.h>
+#include <Athena-Math/Matrix4.h>
 
 
 namespace Athena {
@@ -29,10 +31,14 @@ namespace Entities {
 /// otherwise.
 ///
 /// Each entity contains at least one transforms component.
+///
+/// The actual data of the component is kept in the TransformsStore of the scene (or in
+/// the default store if the component doesn't belong to a scene).
 //----------------------------------------------------------------------------------------
 class ATHENA_ENTITIES_SYMBOL Transforms: public Component
 {
     friend class Entity;
+    friend class TransformsStore;
 
 
     //_____ Internal types __________
@@ -134,7 +140,7 @@ public:
     //------------------------------------------------------------------------------------
     inline Math::Vector3 getPosition() const
     {
-        return m_position;
+        return m_pStore->getPosition(m_uiIndex);
     }
 
 
@@ -253,7 +259,7 @@ public:
     //------------------------------------------------------------------------------------
     inline bool inheritOrientation() const
     {
-        return m_bInheritOrientation;
+        return m_pStore->inheritOrientation(m_uiIndex);
     }
 
     //------------------------------------------------------------------------------------
@@ -267,7 +273,7 @@ public:
     //------------------------------------------------------------------------------------
     inline Math::Quaternion getOrientation() const
     {
-        return m_orientation;
+        return m_pStore->getOrientation(m_uiIndex);
     }
 
 
@@ -371,7 +377,7 @@ public:
     //------------------------------------------------------------------------------------
     inline bool inheritScale() const
     {
-        return m_bInheritScale;
+        return m_pStore->inheritScale(m_uiIndex);
     }
 
     //------------------------------------------------------------------------------------
@@ -384,7 +390,160 @@ public:
     //------------------------------------------------------------------------------------
     inline Math::Vector3 getScale() const
     {
-        return m_scale;
+        return m_pStore->getScale(m_uiIndex);
+    }
+
+
+    //_____ Position, orientation and scale __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the position, orientation and scale of the component relative to its
+    ///         origin at once
+    ///
+    /// The components depending on this one are only notified once
+    ///
+    /// @param  position    The position vector
+    /// @param  orientation The orientation
+    /// @param  scale       The scaling factor
+    //------------------------------------------------------------------------------------
+    void setTransform(const Math::Vector3& position, const Math::Quaternion& orientation,
+                      const Math::Vector3& scale);
+
+
+    //_____ World matrix __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Gets the worldspace transformation matrix of the component
+    ///
+    /// The matrix is cached, and only rebuilt when the world transforms change
+    ///
+    /// @remark The matrix is stored in the TransformsStore of the component, whose arrays
+    ///         can be reallocated when another Transforms is created: don't keep the
+    ///         reference, copy the matrix instead
+    //------------------------------------------------------------------------------------
+    const Math::Matrix4& getWorldMatrix();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Gets the inverse of the worldspace transformation matrix of the component
+    ///
+    /// The matrix is cached, and only rebuilt when the world transforms change
+    ///
+    /// @remark Same as getWorldMatrix(): don't keep the reference
+    //------------------------------------------------------------------------------------
+    const Math::Matrix4& getInverseWorldMatrix();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Converts a point from the local space of the component to world space
+    //------------------------------------------------------------------------------------
+    inline Math::Vector3 transformPoint(const Math::Vector3& point)
+    {
+        return getWorldMatrix().transformAffine(point);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Converts a point from world space to the local space of the component
+    //------------------------------------------------------------------------------------
+    inline Math::Vector3 inverseTransformPoint(const Math::Vector3& point)
+    {
+        return getInverseWorldMatrix().transformAffine(point);
+    }
+
+
+    //_____ Interpolation __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Interpolates the world transforms of the component between the two last
+    ///         frames committed by its scene
+    ///
+    /// The interpolation must be enabled on the scene (see
+    /// Scene::setTransformsInterpolationEnabled()), otherwise the current world
+    /// transforms are returned.
+    ///
+    /// @param  alpha           Interpolation factor (0: previous frame, 1: last frame)
+    /// @param[out] position    The interpolated world position
+    /// @param[out] orientation The interpolated world orientation
+    /// @param[out] scale       The interpolated world scale
+    /// @param  bSlerp          Indicates if the orientations must be interpolated using
+    ///                         a spherical linear interpolation instead of a normalised
+    ///                         linear one
+    //------------------------------------------------------------------------------------
+    void getInterpolatedWorldTransforms(Math::Real alpha, Math::Vector3& position,
+                                        Math::Quaternion& orientation, Math::Vector3& scale,
+                                        bool bSlerp = false);
+
+
+    //_____ Absolute position __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Gets the absolute position of the component, in double precision
+    ///
+    /// The world transforms are relative to the origin of the scene (see
+    /// Scene::rebaseOrigin()): the absolute position is the sum of that origin and of
+    /// the world position.
+    //------------------------------------------------------------------------------------
+    tAbsolutePosition getAbsoluteWorldPosition();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Moves the component to an absolute position
+    ///
+    /// The offset from the origin of the scene is computed in double precision, then
+    /// converted into a position relative to the parent, like translate() does in
+    /// TS_WORLD.
+    ///
+    /// @param  position    The absolute position
+    //------------------------------------------------------------------------------------
+    void setAbsoluteWorldPosition(const tAbsolutePosition& position);
+
+
+    //_____ Storage __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the store containing the data of the component
+    //------------------------------------------------------------------------------------
+    inline TransformsStore* getStore() const
+    {
+        return m_pStore;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the slot of the component in its store
+    //------------------------------------------------------------------------------------
+    inline TransformsStore::tIndex getStoreIndex() const
+    {
+        return m_uiIndex;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Move the data of the component into another store
+    ///
+    /// Used when the entity owning the component is transferred to another scene
+    //------------------------------------------------------------------------------------
+    void _setStore(TransformsStore* pStore);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Release the slot of the component, until _unpark() is called
+    ///
+    /// Used by the entities kept by their scene for a later use: the slot is available
+    /// for the other Transforms components of the store, and the component isn't
+    /// processed anymore. Nothing but _unpark() and the destructor must be called on a
+    /// parked component.
+    ///
+    /// @param  pStore  The store in which a slot will be allocated by _unpark()
+    //------------------------------------------------------------------------------------
+    void _park(TransformsStore* pStore);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocate a new slot for a parked component, initialized with identity
+    ///         transforms
+    //------------------------------------------------------------------------------------
+    void _unpark();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the component is parked (see _park())
+    //------------------------------------------------------------------------------------
+    inline bool _isParked() const
+    {
+        return (m_uiIndex == TransformsStore::INVALID_INDEX);
     }
 
 
@@ -392,12 +551,18 @@ public:
 protected:
     void needUpdate();
     void update();
+    void updateParentIndex();
 
     //-----------------------------------------------------------------------------------
     /// @brief  Called when the transforms affecting this component have changed
     ///
     /// Can be called when the component isn't affected by any transforms anymore
     /// (getTransforms() returns 0).
+    ///
+    /// The notification is only propagated to the components referencing this one if
+    /// the world transforms were up-to-date. A dirty Transforms always has a dirty
+    /// subtree, whose components were already notified: each component is thus
+    /// notified once between two computations of the world transforms.
     //-----------------------------------------------------------------------------------
     virtual void onTransformsChanged();
 
@@ -451,25 +616,14 @@ public:
 
     //_____ Constants __________
 public:
-    static const std::string TYPE;  ///< Name of the type of component
+    static const std::string TYPE;      ///< Name of the type of component
+    static const tTypeID     TYPE_ID;   ///< Identifier of the type of component
 
 
     //_____ Attributes __________
 protected:
-    // Relative transforms
-    Math::Vector3       m_position;
-    Math::Quaternion    m_orientation;
-    Math::Vector3       m_scale;
-
-    // Full (world) transforms
-    Math::Vector3       m_fullPosition;
-    Math::Quaternion    m_fullOrientation;
-    Math::Vector3       m_fullScale;
-
-    bool                m_bDirty;
-    unsigned int        m_uiNbFullCalculationRequests;
-    bool                m_bInheritOrientation;
-    bool                m_bInheritScale;
+    TransformsStore*        m_pStore;   ///< The store containing our data
+    TransformsStore::tIndex m_uiIndex;  ///< Index of our slot in the store
 };
 
 }
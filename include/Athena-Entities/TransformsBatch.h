@@ -0,0 +1,86 @@
+/** @file   TransformsBatch.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::TransformsBatch'
+*/
+
+#ifndef _ATHENA_ENTITIES_TRANSFORMSBATCH_H_
+#define _ATHENA_ENTITIES_TRANSFORMSBATCH_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/Scene.h>
+#include <Athena-Entities/TransformsStore.h>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Scoped batch of modifications of the Transforms of a scene
+///
+/// Until the object is destroyed, the modifications of the Transforms of the scene don't
+/// invalidate their world transforms and aren't notified to the components depending on
+/// them. When the object is destroyed, each modified Transforms propagates the change
+/// once.
+///
+/// Usage:
+/// @code
+/// {
+///     TransformsBatch batch(pScene);
+///
+///     for (...)
+///         pEntity->getTransforms()->setTransform(position, orientation, scale);
+/// }
+/// @endcode
+///
+/// @see    TransformsStore::beginBatch()
+//----------------------------------------------------------------------------------------
+class TransformsBatch
+{
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, starts the batch
+    ///
+    /// @param  pScene  The scene
+    //------------------------------------------------------------------------------------
+    TransformsBatch(Scene* pScene)
+    : m_pStore(pScene->getTransformsStore())
+    {
+        m_pStore->beginBatch();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, starts the batch
+    ///
+    /// @param  pStore  The store
+    //------------------------------------------------------------------------------------
+    TransformsBatch(TransformsStore* pStore)
+    : m_pStore(pStore)
+    {
+        m_pStore->beginBatch();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor, ends the batch
+    //------------------------------------------------------------------------------------
+    ~TransformsBatch()
+    {
+        m_pStore->endBatch();
+    }
+
+private:
+    TransformsBatch(const TransformsBatch&);
+    TransformsBatch& operator=(const TransformsBatch&);
+
+
+    //_____ Attributes __________
+private:
+    TransformsStore* m_pStore;
+};
+
+}
+}
+
+#endif
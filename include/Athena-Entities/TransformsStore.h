@@ -0,0 +1,754 @@
+/** @file   TransformsStore.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::TransformsStore'
+*/
+
+#ifndef _ATHENA_ENTITIES_TRANSFORMSSTORE_H_
+#define _ATHENA_ENTITIES_TRANSFORMSSTORE_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/WorkersPool.h>
+#include <Athena-Entities/tAbsolutePosition.h>
+#include <Athena-Math/Vector3.h>
+#include <Athena-Math/Quaternion.h>
+#include <Athena-Math/Matrix4.h>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Contiguous storage of the data of the Transforms components
+///
+/// The relative and world transforms of all the Transforms components of a scene are
+/// kept in parallel arrays (structure-of-arrays), indexed by a slot number. Each
+/// Transforms component only holds a pointer to its store and the index of its slot.
+///
+/// Alongside the transforms, the store keeps for each slot the index of the parent slot
+/// (if the parent Transforms belongs to the same store), some flags and a 'dirty' bit
+/// indicating that the world transforms must be recomputed.
+///
+/// Each scene owns a store. The Transforms components that aren't part of a scene use
+/// the default store (see getDefault()).
+///
+/// The world transforms are either computed lazily, one slot at a time (when a
+/// Transforms component is asked for them), or for all the slots at once by update().
+///
+/// @remark The arrays can be reallocated when a new slot is allocated: never keep a
+///         pointer or a reference on an element of the store
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL TransformsStore
+{
+    //_____ Internal types __________
+public:
+    typedef unsigned int tIndex;
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Flags associated with each slot
+    //------------------------------------------------------------------------------------
+    enum tFlags
+    {
+        FLAG_USED                   = 0x01,     ///< The slot is in use
+        FLAG_INHERIT_ORIENTATION    = 0x02,     ///< The orientation of the parent is inherited
+        FLAG_INHERIT_SCALE          = 0x04,     ///< The scale of the parent is inherited
+        FLAG_FOREIGN_PARENT         = 0x08,     ///< The parent belongs to another store
+        FLAG_WORLD_MATRIX           = 0x10,     ///< The cached world matrix is up-to-date
+        FLAG_INVERSE_WORLD_MATRIX   = 0x20,     ///< The cached inverse world matrix is up-to-date
+        FLAG_SNAPSHOT               = 0x40,     ///< The slot has a snapshot of the previous frame
+        FLAG_DEFERRED_UPDATE        = 0x80,     ///< Changed during the current batch
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    TransformsStore();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~TransformsStore();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the store used by the Transforms components that don't belong to
+    ///         a scene
+    //------------------------------------------------------------------------------------
+    static TransformsStore* getDefault();
+
+
+    //_____ Threading __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the number of threads used by update()
+    ///
+    /// With more than one thread, the subtrees of the hierarchy are distributed among a
+    /// pool of workers. The results are identical to the ones obtained with one thread.
+    ///
+    /// @param  nbThreads   The number of threads, including the calling one (0: the
+    ///                     number of hardware threads, 1: no worker thread, the default)
+    //------------------------------------------------------------------------------------
+    void setNbThreads(unsigned int nbThreads);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of threads used by update()
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbThreads() const
+    {
+        return (m_pWorkers ? m_pWorkers->getNbThreads() : 1);
+    }
+
+
+    //_____ Management of the slots __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Allocate a new slot, initialized with identity transforms
+    ///
+    /// @param  pTransforms     The Transforms component owning the slot
+    /// @return                 The index of the slot
+    //------------------------------------------------------------------------------------
+    tIndex _allocate(Transforms* pTransforms);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Release a slot
+    ///
+    /// @param  index   The index of the slot
+    //------------------------------------------------------------------------------------
+    void _release(tIndex index);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Preallocate the memory needed by a number of slots, so their allocation
+    ///         doesn't allocate memory
+    ///
+    /// @param  nbSlots     The total number of slots
+    //------------------------------------------------------------------------------------
+    void reserve(unsigned int nbSlots);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of slots currently in use
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbTransforms() const
+    {
+        return (unsigned int) (m_owners.size() - m_freeSlots.size());
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of slots (used or not)
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbSlots() const
+    {
+        return (unsigned int) m_owners.size();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a slot is in use
+    //------------------------------------------------------------------------------------
+    inline bool isUsed(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return (m_flags[index] & FLAG_USED) != 0;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the Transforms component owning a slot
+    //------------------------------------------------------------------------------------
+    inline Transforms* getTransforms(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_owners[index];
+    }
+
+
+    //_____ Relative transforms __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the position of a slot, relative to its parent
+    //------------------------------------------------------------------------------------
+    inline const Math::Vector3& getPosition(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_positions[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the position of a slot, relative to its parent
+    //------------------------------------------------------------------------------------
+    inline void setPosition(tIndex index, const Math::Vector3& position)
+    {
+        assert(index < getNbSlots());
+        m_positions[index] = position;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the orientation of a slot, relative to its parent
+    //------------------------------------------------------------------------------------
+    inline const Math::Quaternion& getOrientation(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_orientations[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the orientation of a slot, relative to its parent
+    //------------------------------------------------------------------------------------
+    inline void setOrientation(tIndex index, const Math::Quaternion& orientation)
+    {
+        assert(index < getNbSlots());
+        m_orientations[index] = orientation;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the scale of a slot, relative to its parent
+    //------------------------------------------------------------------------------------
+    inline const Math::Vector3& getScale(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_scales[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the scale of a slot, relative to its parent
+    //------------------------------------------------------------------------------------
+    inline void setScale(tIndex index, const Math::Vector3& scale)
+    {
+        assert(index < getNbSlots());
+        m_scales[index] = scale;
+    }
+
+
+    //_____ World transforms __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the last computed world position of a slot
+    //------------------------------------------------------------------------------------
+    inline const Math::Vector3& getWorldPosition(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_worldPositions[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the last computed world orientation of a slot
+    //------------------------------------------------------------------------------------
+    inline const Math::Quaternion& getWorldOrientation(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_worldOrientations[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the last computed world scale of a slot
+    //------------------------------------------------------------------------------------
+    inline const Math::Vector3& getWorldScale(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_worldScales[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Stores the world transforms computed for a slot
+    //------------------------------------------------------------------------------------
+    inline void _setWorldTransforms(tIndex index, const Math::Vector3& position,
+                                    const Math::Quaternion& orientation,
+                                    const Math::Vector3& scale)
+    {
+        assert(index < getNbSlots());
+        m_worldPositions[index]    = position;
+        m_worldOrientations[index] = orientation;
+        m_worldScales[index]       = scale;
+        m_flags[index] &= ~(FLAG_WORLD_MATRIX | FLAG_INVERSE_WORLD_MATRIX);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the world matrix of a slot, built from its last computed world
+    ///         transforms
+    ///
+    /// The matrix is cached until the world transforms of the slot are recomputed.
+    //------------------------------------------------------------------------------------
+    inline const Math::Matrix4& getWorldMatrix(tIndex index)
+    {
+        assert(index < getNbSlots());
+
+        if (!(m_flags[index] & FLAG_WORLD_MATRIX))
+        {
+            m_worldMatrices[index].makeTransform(m_worldPositions[index], m_worldScales[index],
+                                                 m_worldOrientations[index]);
+            m_flags[index] |= FLAG_WORLD_MATRIX;
+        }
+
+        return m_worldMatrices[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the inverse world matrix of a slot, built from its last computed
+    ///         world transforms
+    ///
+    /// The matrix is cached until the world transforms of the slot are recomputed.
+    //------------------------------------------------------------------------------------
+    inline const Math::Matrix4& getInverseWorldMatrix(tIndex index)
+    {
+        assert(index < getNbSlots());
+
+        if (!(m_flags[index] & FLAG_INVERSE_WORLD_MATRIX))
+        {
+            m_inverseWorldMatrices[index].makeInverseTransform(m_worldPositions[index],
+                                                               m_worldScales[index],
+                                                               m_worldOrientations[index]);
+            m_flags[index] |= FLAG_INVERSE_WORLD_MATRIX;
+        }
+
+        return m_inverseWorldMatrices[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of a slot without parent, and mark them as
+    ///         up-to-date
+    //------------------------------------------------------------------------------------
+    void _computeWorldTransforms(tIndex index);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of a slot from the world transforms of its
+    ///         parent, and mark them as up-to-date
+    //------------------------------------------------------------------------------------
+    void _computeWorldTransforms(tIndex index, const Math::Vector3& parentPosition,
+                                 const Math::Quaternion& parentOrientation,
+                                 const Math::Vector3& parentScale);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of all the dirty slots
+    ///
+    /// The slots are processed in one linear sweep, ordered so that a parent is always
+    /// processed before its children. That order is cached and only recomputed when the
+    /// hierarchy changes.
+    ///
+    /// The slots of a same depth are independent from each other, and are processed
+    /// by batches of SIMD_WIDTH slots.
+    ///
+    /// When several threads are used (see setNbThreads()), the subtrees are split in
+    /// groups processed in parallel.
+    //------------------------------------------------------------------------------------
+    void update();
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of the dirty slots of one group of subtrees
+    ///
+    /// Doesn't clear the dirty bits (see update())
+    //------------------------------------------------------------------------------------
+    void updateGroup(unsigned int group);
+
+    static void updateGroupTask(void* pUserData, unsigned int task);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of a slot without parent
+    ///
+    /// Doesn't clear the dirty bit
+    //------------------------------------------------------------------------------------
+    void computeWorldTransforms(tIndex index);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of a slot from the world transforms of its
+    ///         parent
+    ///
+    /// Doesn't clear the dirty bit
+    //------------------------------------------------------------------------------------
+    void computeWorldTransforms(tIndex index, const Math::Vector3& parentPosition,
+                                const Math::Quaternion& parentOrientation,
+                                const Math::Vector3& parentScale);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Compute the world transforms of several slots from the world transforms
+    ///         of their parents (which must belong to this store and be up-to-date)
+    ///
+    /// Uses SIMD instructions when available (see TransformsStoreKernels.cpp). Doesn't
+    /// clear the dirty bits.
+    //------------------------------------------------------------------------------------
+    void computeWorldTransformsBatch(const tIndex* pIndices, unsigned int nbIndices);
+
+
+    //_____ Batches __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Starts a batch of modifications
+    ///
+    /// Until the end of the batch, the modifications of the Transforms of this store
+    /// only update their relative transforms: their world transforms aren't invalidated
+    /// and the components depending on them aren't notified. At the end of the batch,
+    /// each modified Transforms propagates the change once.
+    ///
+    /// The batches can be nested: only the end of the outermost one has an effect.
+    ///
+    /// @remark Until the end of the batch, the world transforms of the modified
+    ///         Transforms (and of their children) are out-of-date
+    /// @see    TransformsBatch
+    //------------------------------------------------------------------------------------
+    inline void beginBatch()
+    {
+        ++m_uiBatchLevel;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Ends a batch of modifications
+    ///
+    /// @see    beginBatch()
+    //------------------------------------------------------------------------------------
+    void endBatch();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a batch of modifications is in progress
+    //------------------------------------------------------------------------------------
+    inline bool isInBatch() const
+    {
+        return (m_uiBatchLevel > 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Registers a slot modified during the current batch
+    //------------------------------------------------------------------------------------
+    inline void _deferUpdate(tIndex index)
+    {
+        assert(index < getNbSlots());
+        assert(isInBatch());
+
+        if (!(m_flags[index] & FLAG_DEFERRED_UPDATE))
+        {
+            m_flags[index] |= FLAG_DEFERRED_UPDATE;
+            m_deferred.push_back(index);
+        }
+    }
+
+
+    //_____ Interpolation __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable or disable the snapshots of the world transforms used to interpolate
+    ///         between two frames
+    ///
+    /// When enabled, commitFrame() keeps a copy of the world transforms of all the
+    /// slots at the end of each frame (typically a fixed-rate simulation step), as well
+    /// as the one of the previous frame. The renderer can then interpolate between
+    /// them (see getInterpolatedWorldTransforms()).
+    //------------------------------------------------------------------------------------
+    void setInterpolationEnabled(bool bEnabled);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the snapshots used for the interpolation are enabled
+    //------------------------------------------------------------------------------------
+    inline bool isInterpolationEnabled() const
+    {
+        return m_bInterpolationEnabled;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Marks the end of a frame: compute the world transforms of all the dirty
+    ///         slots and snapshot them
+    ///
+    /// The snapshot of the current frame becomes the one of the previous frame. The slots
+    /// allocated since the last call use their current world transforms for both.
+    ///
+    /// Only calls update() if the interpolation isn't enabled. In both cases, the frame
+    /// counter is incremented.
+    //------------------------------------------------------------------------------------
+    void commitFrame();
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the frame counter (incremented by commitFrame(), starts at 1)
+    //------------------------------------------------------------------------------------
+    inline unsigned int getFrame() const
+    {
+        return m_uiFrame;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the last frame during which the world transforms of a slot were
+    ///         computed (or the slot allocated)
+    //------------------------------------------------------------------------------------
+    inline unsigned int getLastChangeFrame(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_changeFrames[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Interpolates the world transforms of a slot between the two last frames
+    ///
+    /// If the interpolation isn't enabled or if the slot wasn't part of a frame yet, its
+    /// last computed world transforms are returned.
+    ///
+    /// @param  index           The index of the slot
+    /// @param  alpha           Interpolation factor (0: previous frame, 1: last frame)
+    /// @param[out] position    The interpolated world position
+    /// @param[out] orientation The interpolated world orientation
+    /// @param[out] scale       The interpolated world scale
+    /// @param  bSlerp          Indicates if the orientations must be interpolated using
+    ///                         a spherical linear interpolation (slower) instead of a
+    ///                         normalised linear one
+    //------------------------------------------------------------------------------------
+    void getInterpolatedWorldTransforms(tIndex index, Math::Real alpha,
+                                        Math::Vector3& position,
+                                        Math::Quaternion& orientation,
+                                        Math::Vector3& scale, bool bSlerp = false) const;
+
+
+    //_____ Origin __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the absolute position of the origin of the world transforms
+    //------------------------------------------------------------------------------------
+    inline const tAbsolutePosition& getOrigin() const
+    {
+        return m_origin;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Moves the origin of the world transforms
+    ///
+    /// The positions of the slots without parent are shifted by -offset, so the absolute
+    /// positions don't change. The world transforms already computed (and the snapshots
+    /// used for the interpolation) are shifted in the same linear pass, instead of being
+    /// invalidated: the owners of the slots aren't notified.
+    ///
+    /// The slots whose parent belongs to another store (and their subtrees) follow the
+    /// origin of that store, and aren't modified.
+    ///
+    /// @param  offset  Position of the new origin, relative to the current one
+    //------------------------------------------------------------------------------------
+    void rebaseOrigin(const Math::Vector3& offset);
+
+
+    //_____ Hierarchy __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the index of the parent slot
+    ///
+    /// @return The index of the parent, INVALID_INDEX if there is no parent or if it
+    ///         doesn't belong to this store (see hasForeignParent())
+    //------------------------------------------------------------------------------------
+    inline tIndex getParent(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return m_parents[index];
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the parent of a slot belongs to another store
+    //------------------------------------------------------------------------------------
+    inline bool hasForeignParent(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return (m_flags[index] & FLAG_FOREIGN_PARENT) != 0;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets the parent of a slot
+    ///
+    /// @param  index       The index of the slot
+    /// @param  parent      The index of the parent slot, INVALID_INDEX if none
+    /// @param  bForeign    Indicates if the parent belongs to another store
+    //------------------------------------------------------------------------------------
+    void _setParent(tIndex index, tIndex parent, bool bForeign);
+
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Rebuild the list of the used slots, sorted by group of subtrees then by
+    ///         depth in the hierarchy
+    ///
+    /// @param  nbGroups    Maximum number of groups. The subtrees are distributed so
+    ///                     that each group contains roughly the same number of slots.
+    //------------------------------------------------------------------------------------
+    void sortSlots(unsigned int nbGroups);
+
+
+    //_____ Flags __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a slot inherits the orientation of its parent
+    //------------------------------------------------------------------------------------
+    inline bool inheritOrientation(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return (m_flags[index] & FLAG_INHERIT_ORIENTATION) != 0;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets whether a slot inherits the orientation of its parent
+    //------------------------------------------------------------------------------------
+    inline void setInheritOrientation(tIndex index, bool bInherit)
+    {
+        setFlag(index, FLAG_INHERIT_ORIENTATION, bInherit);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if a slot inherits the scale of its parent
+    //------------------------------------------------------------------------------------
+    inline bool inheritScale(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return (m_flags[index] & FLAG_INHERIT_SCALE) != 0;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Sets whether a slot inherits the scale of its parent
+    //------------------------------------------------------------------------------------
+    inline void setInheritScale(tIndex index, bool bInherit)
+    {
+        setFlag(index, FLAG_INHERIT_SCALE, bInherit);
+    }
+
+private:
+    inline void setFlag(tIndex index, unsigned char flag, bool bSet)
+    {
+        assert(index < getNbSlots());
+
+        if (bSet)
+            m_flags[index] |= flag;
+        else
+            m_flags[index] &= ~flag;
+    }
+
+
+    //_____ Dirty state __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the world transforms of a slot must be recomputed
+    //------------------------------------------------------------------------------------
+    inline bool isDirty(tIndex index) const
+    {
+        assert(index < getNbSlots());
+        return (m_dirty[index >> 5] & (1u << (index & 31))) != 0;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Marks the world transforms of a slot as needing an update
+    //------------------------------------------------------------------------------------
+    inline void _setDirty(tIndex index)
+    {
+        assert(index < getNbSlots());
+        m_dirty[index >> 5] |= (1u << (index & 31));
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Marks the world transforms of a slot as up-to-date
+    //------------------------------------------------------------------------------------
+    inline void _clearDirty(tIndex index)
+    {
+        assert(index < getNbSlots());
+        m_dirty[index >> 5] &= ~(1u << (index & 31));
+    }
+
+
+    //_____ Tracking of the changes __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Enable or disable the tracking of the slots whose world transforms change
+    ///
+    /// When enabled, the store keeps the list of the slots allocated, invalidated or
+    /// moved by rebaseOrigin() since the last call to _takeChanges(). Used by the spatial
+    /// index of the scene (see Scene::enableSpatialIndex()).
+    //------------------------------------------------------------------------------------
+    void setChangesTracked(bool bTracked);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the changes of the slots are tracked
+    //------------------------------------------------------------------------------------
+    inline bool areChangesTracked() const
+    {
+        return m_bChangesTracked;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Marks the world transforms of a slot as changed during the current frame,
+    ///         without computing them (see getLastChangeFrame())
+    //------------------------------------------------------------------------------------
+    inline void _markChanged(tIndex index)
+    {
+        assert(index < getNbSlots());
+        m_changeFrames[index] = m_uiFrame;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Registers a slot whose world transforms changed (if the changes are
+    ///         tracked)
+    //------------------------------------------------------------------------------------
+    inline void _trackChange(tIndex index)
+    {
+        assert(index < getNbSlots());
+
+        if (m_bChangesTracked && !(m_changed[index >> 5] & (1u << (index & 31))))
+        {
+            m_changed[index >> 5] |= (1u << (index & 31));
+            m_changes.push_back(index);
+        }
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Retrieves the slots registered since the last call, and clears the list
+    ///
+    /// @param  changes     Receives the slots (they might have been released since)
+    //------------------------------------------------------------------------------------
+    void _takeChanges(std::vector<tIndex>& changes);
+
+
+    //_____ Constants __________
+public:
+    static const tIndex INVALID_INDEX;  ///< Index denoting 'no slot'
+    static const unsigned int SIMD_WIDTH;   ///< Number of slots processed at once by update()
+
+
+    //_____ Attributes __________
+private:
+    // Relative transforms
+    std::vector<Math::Vector3>      m_positions;
+    std::vector<Math::Quaternion>   m_orientations;
+    std::vector<Math::Vector3>      m_scales;
+
+    // Full (world) transforms
+    std::vector<Math::Vector3>      m_worldPositions;
+    std::vector<Math::Quaternion>   m_worldOrientations;
+    std::vector<Math::Vector3>      m_worldScales;
+    std::vector<Math::Matrix4>      m_worldMatrices;        ///< Cached, see FLAG_WORLD_MATRIX
+    std::vector<Math::Matrix4>      m_inverseWorldMatrices; ///< Cached, see FLAG_INVERSE_WORLD_MATRIX
+
+    std::vector<tIndex>             m_parents;      ///< Index of the parent of each slot
+    std::vector<unsigned char>      m_flags;        ///< Flags of each slot
+    std::vector<unsigned int>       m_dirty;        ///< Dirty bitset (one bit per slot)
+    std::vector<Transforms*>        m_owners;       ///< Transforms owning each slot
+    std::vector<unsigned int>       m_changeFrames; ///< See getLastChangeFrame()
+    std::vector<tIndex>             m_freeSlots;    ///< The slots available for reuse
+
+    // Processing order: the used slots, sorted by group of subtrees then by depth
+    std::vector<tIndex>             m_order;
+    std::vector<unsigned int>       m_levels;       ///< Offset of each (group, depth) in m_order
+    unsigned int                    m_nbGroups;
+    unsigned int                    m_nbLevels;     ///< Number of depth levels per group
+    bool                            m_bOrderDirty;  ///< Indicates if m_order must be rebuilt
+    std::vector<std::vector<tIndex> > m_batches;    ///< Temporary lists used by updateGroup()
+
+    WorkersPool*                    m_pWorkers;     ///< Worker threads (0 if only one thread)
+
+    unsigned int                    m_uiFrame;          ///< See getFrame()
+    unsigned int                    m_uiBatchLevel;     ///< Number of nested batches
+    std::vector<tIndex>             m_deferred;         ///< Slots modified during the batch
+
+    // Snapshots of the world transforms of the two last frames (see commitFrame())
+    bool                            m_bInterpolationEnabled;
+    unsigned int                    m_uiCurrentSnapshot;    ///< Index of the last frame
+    std::vector<Math::Vector3>      m_snapshotPositions[2];
+    std::vector<Math::Quaternion>   m_snapshotOrientations[2];
+    std::vector<Math::Vector3>      m_snapshotScales[2];
+
+    // Tracking of the changes (see setChangesTracked())
+    bool                            m_bChangesTracked;
+    std::vector<tIndex>             m_changes;      ///< The slots changed since the last call to _takeChanges()
+    std::vector<unsigned int>       m_changed;      ///< Bitset of the slots in m_changes
+
+    tAbsolutePosition               m_origin;       ///< See getOrigin()
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,103 @@
+/** @file   WorkersPool.h
+    @author Philip Abbet
+
+    Declaration of the class 'Athena::Entities::WorkersPool'
+*/
+
+#ifndef _ATHENA_ENTITIES_WORKERSPOOL_H_
+#define _ATHENA_ENTITIES_WORKERSPOOL_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Pool of worker threads, used to execute a list of independent tasks in
+///         parallel
+///
+/// The threads are started once, and sleep between two calls to run(). The calling
+/// thread takes part in the execution of the tasks.
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL WorkersPool
+{
+    //_____ Internal types __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Function executing one task
+    ///
+    /// @param  pUserData   The user data given to run()
+    /// @param  task        Index of the task to execute
+    //------------------------------------------------------------------------------------
+    typedef void (*tTaskFunction)(void* pUserData, unsigned int task);
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    ///
+    /// @param  nbThreads   Number of threads executing the tasks, including the calling
+    ///                     thread (0: the number of hardware threads)
+    //------------------------------------------------------------------------------------
+    WorkersPool(unsigned int nbThreads);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~WorkersPool();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of threads executing the tasks, including the calling
+    ///         thread
+    //------------------------------------------------------------------------------------
+    inline unsigned int getNbThreads() const
+    {
+        return (unsigned int) m_threads.size() + 1;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Execute a list of tasks, and wait until all of them are done
+    ///
+    /// The order in which the tasks are executed isn't specified
+    ///
+    /// @param  function    The function executing one task
+    /// @param  pUserData   User data given to the function
+    /// @param  nbTasks     Number of tasks to execute
+    //------------------------------------------------------------------------------------
+    void run(tTaskFunction function, void* pUserData, unsigned int nbTasks);
+
+private:
+    void workerMain();
+    void processTasks();
+
+
+    //_____ Attributes __________
+private:
+    std::vector<std::thread>    m_threads;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_wakeUp;       ///< Signaled when there is work to do
+    std::condition_variable     m_done;         ///< Signaled when the workers are done
+    tTaskFunction               m_function;
+    void*                       m_pUserData;
+    unsigned int                m_nbTasks;
+    std::atomic<unsigned int>   m_nextTask;     ///< Index of the next task to execute
+    unsigned int                m_nbBusyWorkers;
+    unsigned int                m_uiGeneration; ///< Incremented at each call to run()
+    bool                        m_bQuit;
+};
+
+}
+}
+
+#endif
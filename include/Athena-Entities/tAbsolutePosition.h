@@ -0,0 +1,101 @@
+/** @file   tAbsolutePosition.h
+    @author Philip Abbet
+
+    Definition of the type 'Athena::Entities::tAbsolutePosition'
+*/
+
+#ifndef _ATHENA_ENTITIES_TABSOLUTEPOSITION_H_
+#define _ATHENA_ENTITIES_TABSOLUTEPOSITION_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Math/Vector3.h>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Double-precision position in a world larger than the range in which the
+///         precision of Math::Real is sufficient
+///
+/// The world transforms of the Transforms components are relative to the origin of
+/// their scene (see Scene::rebaseOrigin()). The absolute position of a component is the
+/// sum of that origin (kept in double precision) and of its world position.
+//----------------------------------------------------------------------------------------
+struct ATHENA_ENTITIES_SYMBOL tAbsolutePosition
+{
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    tAbsolutePosition()
+    : x(0.0), y(0.0), z(0.0)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    tAbsolutePosition(double fX, double fY, double fZ)
+    : x(fX), y(fY), z(fZ)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    explicit tAbsolutePosition(const Math::Vector3& position)
+    : x(position.x), y(position.y), z(position.z)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the position moved by an offset
+    //------------------------------------------------------------------------------------
+    inline tAbsolutePosition operator+(const Math::Vector3& offset) const
+    {
+        return tAbsolutePosition(x + offset.x, y + offset.y, z + offset.z);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Moves the position by an offset
+    //------------------------------------------------------------------------------------
+    inline tAbsolutePosition& operator+=(const Math::Vector3& offset)
+    {
+        x += offset.x;
+        y += offset.y;
+        z += offset.z;
+        return *this;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the offset between two positions
+    ///
+    /// The difference is computed in double precision before being converted
+    //------------------------------------------------------------------------------------
+    inline Math::Vector3 operator-(const tAbsolutePosition& position) const
+    {
+        return Math::Vector3((Math::Real) (x - position.x), (Math::Real) (y - position.y),
+                             (Math::Real) (z - position.z));
+    }
+
+    inline bool operator==(const tAbsolutePosition& position) const
+    {
+        return (x == position.x) && (y == position.y) && (z == position.z);
+    }
+
+    inline bool operator!=(const tAbsolutePosition& position) const
+    {
+        return !(*this == position);
+    }
+
+
+    double x;
+    double y;
+    double z;
+};
+
+}
+}
+
+#endif
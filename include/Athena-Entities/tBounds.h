@@ -0,0 +1,112 @@
+/** @file   tBounds.h
+    @author Philip Abbet
+
+    Definition of the type 'Athena::Entities::tBounds'
+*/
+
+#ifndef _ATHENA_ENTITIES_TBOUNDS_H_
+#define _ATHENA_ENTITIES_TBOUNDS_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Math/Vector3.h>
+#include <Athena-Math/Matrix4.h>
+#include <cmath>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Axis-aligned bounding box
+///
+/// Used for the bounds of the entities (see Entity::setBounds()), expressed in the local
+/// space of their transforms, and for their world bounds in the bounds hierarchy of their
+/// scene (see BoundsHierarchy).
+//----------------------------------------------------------------------------------------
+struct ATHENA_ENTITIES_SYMBOL tBounds
+{
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    tBounds()
+    : min(Math::Vector3::ZERO), max(Math::Vector3::ZERO)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    //------------------------------------------------------------------------------------
+    tBounds(const Math::Vector3& minimum, const Math::Vector3& maximum)
+    : min(minimum), max(maximum)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Enlarges the box to contain another one
+    //------------------------------------------------------------------------------------
+    inline void merge(const tBounds& bounds)
+    {
+        min.makeFloor(bounds.min);
+        max.makeCeil(bounds.max);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the box contains another one
+    //------------------------------------------------------------------------------------
+    inline bool contains(const tBounds& bounds) const
+    {
+        return (bounds.min.x >= min.x) && (bounds.min.y >= min.y) && (bounds.min.z >= min.z) &&
+               (bounds.max.x <= max.x) && (bounds.max.y <= max.y) && (bounds.max.z <= max.z);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the surface area of the box
+    //------------------------------------------------------------------------------------
+    inline Math::Real getSurfaceArea() const
+    {
+        Math::Vector3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the axis-aligned box containing this one once transformed by an
+    ///         affine matrix
+    //------------------------------------------------------------------------------------
+    inline tBounds transformed(const Math::Matrix4& matrix) const
+    {
+        Math::Vector3 center = (min + max) * 0.5f;
+        Math::Vector3 halfSize = (max - min) * 0.5f;
+
+        center = matrix.transformAffine(center);
+
+        Math::Vector3 extent(
+            std::fabs(matrix[0][0]) * halfSize.x + std::fabs(matrix[0][1]) * halfSize.y +
+                std::fabs(matrix[0][2]) * halfSize.z,
+            std::fabs(matrix[1][0]) * halfSize.x + std::fabs(matrix[1][1]) * halfSize.y +
+                std::fabs(matrix[1][2]) * halfSize.z,
+            std::fabs(matrix[2][0]) * halfSize.x + std::fabs(matrix[2][1]) * halfSize.y +
+                std::fabs(matrix[2][2]) * halfSize.z);
+
+        return tBounds(center - extent, center + extent);
+    }
+
+    inline bool operator==(const tBounds& bounds) const
+    {
+        return (min == bounds.min) && (max == bounds.max);
+    }
+
+    inline bool operator!=(const tBounds& bounds) const
+    {
+        return !(*this == bounds);
+    }
+
+
+    Math::Vector3 min;
+    Math::Vector3 max;
+};
+
+}
+}
+
+#endif
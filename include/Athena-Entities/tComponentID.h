@@ -8,6 +8,7 @@
 #define _ATHENA_ENTITIES_TCOMPONENTID_H_
 
 #include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/tSymbol.h>
 
 
 namespace Athena {
@@ -31,9 +32,23 @@ enum tComponentType
 
 //----------------------------------------------------------------------------------------
 /// @brief  Represents an ID identifying a component of an entity
+///
+/// The names are interned (see tSymbol): two IDs are compared and hashed in constant
+/// time.
 //----------------------------------------------------------------------------------------
 struct ATHENA_ENTITIES_SYMBOL tComponentID
 {
+    //------------------------------------------------------------------------------------
+    /// @brief  Hash function, to use the IDs as keys of the unordered containers
+    //------------------------------------------------------------------------------------
+    struct tHash
+    {
+        inline size_t operator()(const tComponentID& id) const
+        {
+            return (id.strName.hash() * 31 + id.strEntity.hash()) * 31 + (size_t) id.type;
+        }
+    };
+
     //------------------------------------------------------------------------------------
     /// @brief  Constructor
     /// @param  theType             Type of component
@@ -52,7 +67,7 @@ struct ATHENA_ENTITIES_SYMBOL tComponentID
     /// @param  strComponentName    Name of the component
     //------------------------------------------------------------------------------------
     tComponentID(tComponentType theType, const std::string& strComponentName)
-    : type(theType), strEntity(""), strName(strComponentName)
+    : type(theType), strName(strComponentName)
     {
     }
 
@@ -61,7 +76,7 @@ struct ATHENA_ENTITIES_SYMBOL tComponentID
     /// @param  theType     Type of component
     //------------------------------------------------------------------------------------
     tComponentID(tComponentType theType)
-    : type(theType), strEntity(""), strName("")
+    : type(theType)
     {
     }
 
@@ -70,34 +85,35 @@ struct ATHENA_ENTITIES_SYMBOL tComponentID
     /// @param  strID       String representation of a component ID
     //------------------------------------------------------------------------------------
     tComponentID(const std::string& strID)
-    : type(COMP_NONE), strEntity(""), strName("")
+    : type(COMP_NONE)
     {
         size_t index = strID.find("://");
         if (index != std::string::npos)
         {
             size_t index2 = strID.find(":", index + 3);
 
+            // The parts of the string are interned without being copied
             if (index2 != std::string::npos)
             {
-                strEntity = strID.substr(index + 3, index2 - (index + 3));
-                strName = strID.substr(index2 + 1);
+                strEntity = tSymbol(strID.c_str() + index + 3, index2 - (index + 3));
+                strName = tSymbol(strID.c_str() + index2 + 1, strID.size() - (index2 + 1));
             }
             else
             {
-                strName = strID.substr(index + 3);
+                strName = tSymbol(strID.c_str() + index + 3, strID.size() - (index + 3));
             }
 
-            if (strID.substr(0, index) == "Transforms")
+            if (strID.compare(0, index, "Transforms") == 0)
                 type = COMP_TRANSFORMS;
-            else if (strID.substr(0, index) == "Visual")
+            else if (strID.compare(0, index, "Visual") == 0)
                 type = COMP_VISUAL;
-            else if (strID.substr(0, index) == "Audio")
+            else if (strID.compare(0, index, "Audio") == 0)
                 type = COMP_AUDIO;
-            else if (strID.substr(0, index) == "Physical")
+            else if (strID.compare(0, index, "Physical") == 0)
                 type = COMP_PHYSICAL;
-            else if (strID.substr(0, index) == "Debug")
+            else if (strID.compare(0, index, "Debug") == 0)
                 type = COMP_DEBUG;
-            else if (strID.substr(0, index) == "Other")
+            else if (strID.compare(0, index, "Other") == 0)
                 type = COMP_OTHER;
         }
     }
@@ -123,11 +139,11 @@ struct ATHENA_ENTITIES_SYMBOL tComponentID
     //------------------------------------------------------------------------------------
     std::string toString() const
     {
-        assert(strEntity.find(":") == std::string::npos);
+        assert(strEntity.str().find(":") == std::string::npos);
 
         std::string suffix = strName;
         if (!strEntity.empty())
-            suffix = strEntity + ":" + suffix;
+            suffix = strEntity.str() + ":" + suffix;
 
         if (type == COMP_TRANSFORMS)
             return "Transforms://" + suffix;
@@ -147,8 +163,8 @@ struct ATHENA_ENTITIES_SYMBOL tComponentID
 
 
     tComponentType  type;       ///< Type of component
-    std::string     strEntity;  ///< Name of the entity holding the component
-    std::string     strName;    ///< Name of the component
+    tSymbol         strEntity;  ///< Name of the entity holding the component
+    tSymbol         strName;    ///< Name of the component
 };
 
 }
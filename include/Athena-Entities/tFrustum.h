@@ -0,0 +1,126 @@
+/** @file   tFrustum.h
+    @author Philip Abbet
+
+    Definition of the type 'Athena::Entities::tFrustum'
+*/
+
+#ifndef _ATHENA_ENTITIES_TFRUSTUM_H_
+#define _ATHENA_ENTITIES_TFRUSTUM_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <Athena-Entities/tBounds.h>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Convex volume delimited by six planes, used to retrieve the entities seen by
+///         a camera (see BoundsHierarchy::getEntitiesInFrustum())
+///
+/// A point is inside the frustum when it is on the positive side of all the planes
+/// (dot(normal, point) + d >= 0). The planes don't need to be normalized.
+//----------------------------------------------------------------------------------------
+struct ATHENA_ENTITIES_SYMBOL tFrustum
+{
+    //_____ Internal types __________
+    struct tPlane
+    {
+        Math::Vector3   normal;
+        Math::Real      d;
+    };
+
+    enum tPlaneIndex
+    {
+        PLANE_LEFT,
+        PLANE_RIGHT,
+        PLANE_BOTTOM,
+        PLANE_TOP,
+        PLANE_NEAR,
+        PLANE_FAR,
+
+        NB_PLANES
+    };
+
+    /// Result of classify()
+    enum tClassification
+    {
+        OUTSIDE,
+        INTERSECTING,
+        INSIDE
+    };
+
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the frustum corresponding to a view-projection matrix
+    ///
+    /// @param  viewProjection  The matrix (projecting the visible points in the [-1, 1]
+    ///                         range on each axis)
+    //------------------------------------------------------------------------------------
+    static tFrustum fromMatrix(const Math::Matrix4& viewProjection)
+    {
+        tFrustum frustum;
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            tPlane& lower = frustum.planes[i * 2];
+            tPlane& upper = frustum.planes[i * 2 + 1];
+
+            lower.normal.x = viewProjection[3][0] + viewProjection[i][0];
+            lower.normal.y = viewProjection[3][1] + viewProjection[i][1];
+            lower.normal.z = viewProjection[3][2] + viewProjection[i][2];
+            lower.d        = viewProjection[3][3] + viewProjection[i][3];
+
+            upper.normal.x = viewProjection[3][0] - viewProjection[i][0];
+            upper.normal.y = viewProjection[3][1] - viewProjection[i][1];
+            upper.normal.z = viewProjection[3][2] - viewProjection[i][2];
+            upper.d        = viewProjection[3][3] - viewProjection[i][3];
+        }
+
+        return frustum;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if an axis-aligned box is outside the frustum, inside it or
+    ///         intersects its planes
+    ///
+    /// @remark Conservative: a box near a corner of the frustum can be considered as
+    ///         intersecting it while being outside
+    //------------------------------------------------------------------------------------
+    inline tClassification classify(const tBounds& bounds) const
+    {
+        tClassification result = INSIDE;
+
+        for (unsigned int i = 0; i < NB_PLANES; ++i)
+        {
+            const tPlane& plane = planes[i];
+
+            // The corners of the box the farthest along the normal, and in the opposite
+            // direction
+            Math::Vector3 positive((plane.normal.x >= 0.0f ? bounds.max.x : bounds.min.x),
+                                   (plane.normal.y >= 0.0f ? bounds.max.y : bounds.min.y),
+                                   (plane.normal.z >= 0.0f ? bounds.max.z : bounds.min.z));
+
+            if (plane.normal.dotProduct(positive) + plane.d < 0.0f)
+                return OUTSIDE;
+
+            Math::Vector3 negative((plane.normal.x >= 0.0f ? bounds.min.x : bounds.max.x),
+                                   (plane.normal.y >= 0.0f ? bounds.min.y : bounds.max.y),
+                                   (plane.normal.z >= 0.0f ? bounds.min.z : bounds.max.z));
+
+            if (plane.normal.dotProduct(negative) + plane.d < 0.0f)
+                result = INTERSECTING;
+        }
+
+        return result;
+    }
+
+
+    tPlane planes[NB_PLANES];
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,74 @@
+/** @file   tHandle.h
+    @author Philip Abbet
+
+    Definition of the type 'Athena::Entities::tHandle'
+*/
+
+#ifndef _ATHENA_ENTITIES_THANDLE_H_
+#define _ATHENA_ENTITIES_THANDLE_H_
+
+#include <Athena-Entities/Prerequisites.h>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Weak reference to an entity or a component of a scene
+///
+/// A handle is made of the index of a slot in a table of the scene, and of the
+/// generation of that slot when the handle was created. The generation changes each time
+/// the slot is released, so a handle to a destroyed object resolves to 0 instead of to
+/// the object reusing its slot.
+///
+/// @see    Scene::getEntity(const tHandle&), Scene::getComponent(const tHandle&)
+//----------------------------------------------------------------------------------------
+struct ATHENA_ENTITIES_SYMBOL tHandle
+{
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, for an invalid handle
+    //------------------------------------------------------------------------------------
+    tHandle()
+    : uiIndex(0), uiGeneration(0)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    /// @param  index       Index of the slot
+    /// @param  generation  Generation of the slot
+    //------------------------------------------------------------------------------------
+    tHandle(unsigned int index, unsigned int generation)
+    : uiIndex(index), uiGeneration(generation)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the handle was given by a scene (the object might have been
+    ///         destroyed since)
+    //------------------------------------------------------------------------------------
+    inline bool isValid() const
+    {
+        return (uiGeneration != 0);
+    }
+
+    inline bool operator==(const tHandle& handle) const
+    {
+        return (uiIndex == handle.uiIndex) && (uiGeneration == handle.uiGeneration);
+    }
+
+    inline bool operator!=(const tHandle& handle) const
+    {
+        return (uiIndex != handle.uiIndex) || (uiGeneration != handle.uiGeneration);
+    }
+
+
+    unsigned int uiIndex;       ///< Index of the slot
+    unsigned int uiGeneration;  ///< Generation of the slot (0 for an invalid handle)
+};
+
+}
+}
+
+#endif
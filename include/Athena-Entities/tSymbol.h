@@ -0,0 +1,257 @@
+/** @file   tSymbol.h
+    @author Philip Abbet
+
+    Definition of the type 'Athena::Entities::tSymbol'
+*/
+
+#ifndef _ATHENA_ENTITIES_TSYMBOL_H_
+#define _ATHENA_ENTITIES_TSYMBOL_H_
+
+#include <Athena-Entities/Prerequisites.h>
+#include <atomic>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+
+namespace Athena {
+namespace Entities {
+
+
+//----------------------------------------------------------------------------------------
+/// @brief  Interned string
+///
+/// All the symbols created from the same string share a single copy of it, stored in a
+/// global table. Two symbols can thus be compared or hashed in constant time, by
+/// comparing the address of their string.
+///
+/// The strings are reference-counted: a string is removed from the table once the last
+/// symbol using it is destroyed.
+///
+/// A symbol can be used where a 'const std::string&' is expected, and compared with
+/// strings.
+///
+/// @remark The creation of a symbol from a string requires a lookup in the global table
+///         (protected by a mutex): copy the symbols instead of creating them repeatedly
+//----------------------------------------------------------------------------------------
+class ATHENA_ENTITIES_SYMBOL tSymbol
+{
+    //_____ Internal types __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Hash function, to use the symbols as keys of the unordered containers
+    //------------------------------------------------------------------------------------
+    struct tHash
+    {
+        inline size_t operator()(const tSymbol& symbol) const
+        {
+            return symbol.hash();
+        }
+    };
+
+
+    //_____ Construction / Destruction __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, for the empty symbol
+    //------------------------------------------------------------------------------------
+    tSymbol()
+    : m_pEntry(0)
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    /// @param  str     The string
+    //------------------------------------------------------------------------------------
+    tSymbol(const std::string& str)
+    : m_pEntry(intern(str.c_str(), str.size()))
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor
+    /// @param  str     The string
+    //------------------------------------------------------------------------------------
+    tSymbol(const char* str)
+    : m_pEntry(intern(str, strlen(str)))
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Constructor, from a part of a string
+    /// @param  str     The first character of the string
+    /// @param  length  The number of characters
+    //------------------------------------------------------------------------------------
+    tSymbol(const char* str, size_t length)
+    : m_pEntry(intern(str, length))
+    {
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Copy constructor (doesn't lookup the table)
+    //------------------------------------------------------------------------------------
+    tSymbol(const tSymbol& symbol)
+    : m_pEntry(symbol.m_pEntry)
+    {
+        if (m_pEntry)
+            m_pEntry->second.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Destructor
+    //------------------------------------------------------------------------------------
+    ~tSymbol()
+    {
+        if (m_pEntry)
+            release(m_pEntry);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Assignment operator (doesn't lookup the table)
+    //------------------------------------------------------------------------------------
+    tSymbol& operator=(const tSymbol& symbol)
+    {
+        if (symbol.m_pEntry)
+            symbol.m_pEntry->second.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_pEntry)
+            release(m_pEntry);
+
+        m_pEntry = symbol.m_pEntry;
+        return *this;
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the number of strings in the global table
+    //------------------------------------------------------------------------------------
+    static unsigned int getNbStrings();
+
+
+    //_____ Methods __________
+public:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the string of the symbol
+    //------------------------------------------------------------------------------------
+    inline const std::string& str() const
+    {
+        return (m_pEntry ? m_pEntry->first : EMPTY);
+    }
+
+    inline operator const std::string&() const
+    {
+        return str();
+    }
+
+    inline const char* c_str() const
+    {
+        return str().c_str();
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Indicates if the symbol is the empty one
+    //------------------------------------------------------------------------------------
+    inline bool empty() const
+    {
+        return (m_pEntry == 0);
+    }
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns the hash value of the symbol
+    //------------------------------------------------------------------------------------
+    inline size_t hash() const
+    {
+        // The entries are allocated on (at least) 8-bytes boundaries
+        return ((size_t) m_pEntry) >> 3;
+    }
+
+    inline bool operator==(const tSymbol& symbol) const
+    {
+        return (m_pEntry == symbol.m_pEntry);
+    }
+
+    inline bool operator!=(const tSymbol& symbol) const
+    {
+        return (m_pEntry != symbol.m_pEntry);
+    }
+
+    inline bool operator==(const std::string& str) const
+    {
+        return (this->str() == str);
+    }
+
+    inline bool operator!=(const std::string& str) const
+    {
+        return (this->str() != str);
+    }
+
+    inline bool operator==(const char* str) const
+    {
+        return (this->str() == str);
+    }
+
+    inline bool operator!=(const char* str) const
+    {
+        return (this->str() != str);
+    }
+
+    //_____ Internal types __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Entry of the global table: the string and its number of references
+    //------------------------------------------------------------------------------------
+    typedef std::pair<const std::string, std::atomic<unsigned int> > tEntry;
+
+
+    //_____ Methods __________
+private:
+    //------------------------------------------------------------------------------------
+    /// @brief  Returns a new reference to the interned copy of a string (0 for the
+    ///         empty string)
+    //------------------------------------------------------------------------------------
+    static tEntry* intern(const char* str, size_t length);
+
+    //------------------------------------------------------------------------------------
+    /// @brief  Release a reference to an interned string, removed from the table if it
+    ///         was the last one
+    //------------------------------------------------------------------------------------
+    static void release(tEntry* pEntry);
+
+
+    //_____ Attributes __________
+private:
+    static const std::string EMPTY;
+
+    tEntry* m_pEntry;   ///< The interned string, 0 for the empty symbol
+};
+
+
+inline bool operator==(const std::string& str, const tSymbol& symbol)
+{
+    return (symbol == str);
+}
+
+inline bool operator!=(const std::string& str, const tSymbol& symbol)
+{
+    return (symbol != str);
+}
+
+inline bool operator==(const char* str, const tSymbol& symbol)
+{
+    return (symbol == str);
+}
+
+inline bool operator!=(const char* str, const tSymbol& symbol)
+{
+    return (symbol != str);
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const tSymbol& symbol)
+{
+    return stream << symbol.str();
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,125 @@
+/** @file   Archetype.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::Archetype'
+*/
+
+#include <Athena-Entities/Archetype.h>
+
+using namespace Athena::Entities;
+using namespace std;
+
+
+/************************************** CONSTANTS ***************************************/
+
+const unsigned int Archetype::CHUNK_SIZE;
+const unsigned int Archetype::INVALID_COLUMN;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+Archetype::Archetype(const tSignature& signature)
+: m_signature(signature), m_nbEntities(0)
+{
+    assert(!signature.empty());
+}
+
+//-----------------------------------------------------------------------
+
+Archetype::~Archetype()
+{
+    for (unsigned int i = 0; i < m_chunks.size(); ++i)
+    {
+        delete[] m_chunks[i].pEntities;
+        delete[] m_chunks[i].pComponents;
+    }
+}
+
+
+/*************************************** METHODS ****************************************/
+
+unsigned int Archetype::getColumn(Component::tTypeID typeID, unsigned int occurrence) const
+{
+    for (unsigned int i = 0; i < m_signature.size(); ++i)
+    {
+        if (m_signature[i] == typeID)
+        {
+            if (occurrence == 0)
+                return i;
+
+            --occurrence;
+        }
+    }
+
+    return INVALID_COLUMN;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Archetype::_addEntity(Entity* pEntity, Component* const* components)
+{
+    // Assertions
+    assert(pEntity);
+    assert(components);
+
+    // Allocate a new chunk if needed
+    if (m_nbEntities == m_chunks.size() * CHUNK_SIZE)
+    {
+        tChunk chunk;
+        chunk.pEntities = new Entity*[CHUNK_SIZE];
+        chunk.pComponents = new Component*[m_signature.size() * CHUNK_SIZE];
+        chunk.nbEntities = 0;
+
+        m_chunks.push_back(chunk);
+    }
+
+    tChunk& chunk = m_chunks.back();
+    unsigned int row = chunk.nbEntities;
+
+    chunk.pEntities[row] = pEntity;
+
+    for (unsigned int i = 0; i < m_signature.size(); ++i)
+        chunk.pComponents[i * CHUNK_SIZE + row] = components[i];
+
+    ++chunk.nbEntities;
+
+    return m_nbEntities++;
+}
+
+//-----------------------------------------------------------------------
+
+Entity* Archetype::_removeEntity(unsigned int index)
+{
+    // Assertions
+    assert(index < m_nbEntities);
+
+    tChunk& chunk = m_chunks[index / CHUNK_SIZE];
+    unsigned int row = index % CHUNK_SIZE;
+
+    tChunk& lastChunk = m_chunks.back();
+    unsigned int lastRow = lastChunk.nbEntities - 1;
+
+    // Move the last entity in the hole
+    Entity* pMovedEntity = 0;
+    if (index != m_nbEntities - 1)
+    {
+        pMovedEntity = lastChunk.pEntities[lastRow];
+        chunk.pEntities[row] = pMovedEntity;
+
+        for (unsigned int i = 0; i < m_signature.size(); ++i)
+            chunk.pComponents[i * CHUNK_SIZE + row] = lastChunk.pComponents[i * CHUNK_SIZE + lastRow];
+    }
+
+    --lastChunk.nbEntities;
+    --m_nbEntities;
+
+    // Release the last chunk once empty
+    if (lastChunk.nbEntities == 0)
+    {
+        delete[] lastChunk.pEntities;
+        delete[] lastChunk.pComponents;
+        m_chunks.pop_back();
+    }
+
+    return pMovedEntity;
+}
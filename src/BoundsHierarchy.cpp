@@ -0,0 +1,470 @@
+/** @file   BoundsHierarchy.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::BoundsHierarchy'
+*/
+
+#include <Athena-Entities/BoundsHierarchy.h>
+#include <algorithm>
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace std;
+
+
+/************************************** CONSTANTS ***************************************/
+
+const unsigned int BoundsHierarchy::NO_NODE;
+
+/// Flag set on the nodes of the traversal stack which are entirely inside the frustum
+static const unsigned int INSIDE_FLAG = 0x80000000;
+
+
+/*********************************** STATIC FUNCTIONS ***********************************/
+
+//------------------------------------------------------------------------------------
+/// @brief  Computes the distance at which a ray enters a box (slab method)
+///
+/// @return False if the ray misses the box
+//------------------------------------------------------------------------------------
+static bool intersects(const tBounds& bounds, const Vector3& origin,
+                       const Vector3& invDirection, Real maxDistance, Real& distance)
+{
+    Real tMin = 0.0f;
+    Real tMax = maxDistance;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        Real t1 = (bounds.min[i] - origin[i]) * invDirection[i];
+        Real t2 = (bounds.max[i] - origin[i]) * invDirection[i];
+
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        if (t1 > tMin)
+            tMin = t1;
+
+        if (t2 < tMax)
+            tMax = t2;
+
+        if (tMin > tMax)
+            return false;
+    }
+
+    distance = tMin;
+    return true;
+}
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+BoundsHierarchy::BoundsHierarchy()
+: m_root(NO_NODE), m_freeNodes(NO_NODE), m_nbEntities(0)
+{
+}
+
+//-----------------------------------------------------------------------
+
+BoundsHierarchy::~BoundsHierarchy()
+{
+}
+
+
+/*************************************** QUERIES ****************************************/
+
+unsigned int BoundsHierarchy::castRay(const Vector3& origin, const Vector3& direction,
+                                      Real maxDistance, tRayHit* pHits,
+                                      unsigned int maxHits) const
+{
+    // Assertions
+    assert(pHits || (maxHits == 0));
+
+    if ((m_root == NO_NODE) || (maxHits == 0))
+        return 0;
+
+    // Declarations
+    unsigned int nbHits = 0;
+    Real distance;
+    Vector3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+    m_stack.clear();
+    m_stack.push_back(m_root);
+
+    while (!m_stack.empty())
+    {
+        unsigned int index = m_stack.back();
+        m_stack.pop_back();
+
+        const tNode& node = m_nodes[index];
+
+        if (!intersects(node.bounds, origin, invDirection, maxDistance, distance))
+            continue;
+
+        // Once the buffer is full, only the nodes nearer than the farthest hit matter
+        if ((nbHits == maxHits) && (distance >= pHits[nbHits - 1].distance))
+            continue;
+
+        if (node.children[0] != NO_NODE)
+        {
+            m_stack.push_back(node.children[0]);
+            m_stack.push_back(node.children[1]);
+            continue;
+        }
+
+        // Insert the hit in the sorted buffer (dropping the farthest one if full)
+        unsigned int position = (nbHits < maxHits ? nbHits++ : nbHits - 1);
+        while ((position > 0) && (pHits[position - 1].distance > distance))
+        {
+            pHits[position] = pHits[position - 1];
+            --position;
+        }
+
+        pHits[position].pEntity = m_entries[node.entry].pEntity;
+        pHits[position].distance = distance;
+    }
+
+    return nbHits;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int BoundsHierarchy::getEntitiesInFrustum(const tFrustum& frustum,
+                                                   Entity** pEntities,
+                                                   unsigned int maxEntities) const
+{
+    // Assertions
+    assert(pEntities || (maxEntities == 0));
+
+    if (m_root == NO_NODE)
+        return 0;
+
+    // Declarations
+    unsigned int nbEntities = 0;
+
+    m_stack.clear();
+    m_stack.push_back(m_root);
+
+    while (!m_stack.empty())
+    {
+        unsigned int index = m_stack.back();
+        m_stack.pop_back();
+
+        // The nodes entirely inside the frustum don't need to be tested
+        unsigned int flag = (index & INSIDE_FLAG);
+        index &= ~INSIDE_FLAG;
+
+        const tNode& node = m_nodes[index];
+
+        if (!flag)
+        {
+            tFrustum::tClassification classification = frustum.classify(node.bounds);
+            if (classification == tFrustum::OUTSIDE)
+                continue;
+
+            if (classification == tFrustum::INSIDE)
+                flag = INSIDE_FLAG;
+        }
+
+        if (node.children[0] != NO_NODE)
+        {
+            m_stack.push_back(node.children[0] | flag);
+            m_stack.push_back(node.children[1] | flag);
+            continue;
+        }
+
+        if (nbEntities < maxEntities)
+            pEntities[nbEntities] = m_entries[node.entry].pEntity;
+
+        ++nbEntities;
+    }
+
+    return nbEntities;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+unsigned int BoundsHierarchy::getDepth() const
+{
+    if (m_root == NO_NODE)
+        return 0;
+
+    // Declarations
+    unsigned int depth = 0;
+    std::vector<std::pair<unsigned int, unsigned int> > stack;
+
+    stack.push_back(make_pair(m_root, 1u));
+
+    while (!stack.empty())
+    {
+        std::pair<unsigned int, unsigned int> current = stack.back();
+        stack.pop_back();
+
+        depth = std::max(depth, current.second);
+
+        if (!isLeaf(current.first))
+        {
+            stack.push_back(make_pair(m_nodes[current.first].children[0], current.second + 1));
+            stack.push_back(make_pair(m_nodes[current.first].children[1], current.second + 1));
+        }
+    }
+
+    return depth;
+}
+
+//-----------------------------------------------------------------------
+
+bool BoundsHierarchy::contains(Entity* pEntity) const
+{
+    // Assertions
+    assert(pEntity);
+
+    unsigned int entry = pEntity->getHandle().uiIndex;
+    return (entry < m_entries.size()) && (m_entries[entry].pEntity == pEntity);
+}
+
+//-----------------------------------------------------------------------
+
+const tBounds& BoundsHierarchy::getBounds(Entity* pEntity) const
+{
+    // Assertions
+    assert(contains(pEntity));
+
+    return m_nodes[m_entries[pEntity->getHandle().uiIndex].leaf].bounds;
+}
+
+//-----------------------------------------------------------------------
+
+void BoundsHierarchy::_update(Entity* pEntity, const tBounds& bounds)
+{
+    // Assertions
+    assert(pEntity);
+    assert(pEntity->getHandle().isValid());
+
+    unsigned int index = pEntity->getHandle().uiIndex;
+
+    if (index >= m_entries.size())
+    {
+        tEntry empty = { 0, NO_NODE };
+        m_entries.resize(index + 1, empty);
+    }
+
+    tEntry& entry = m_entries[index];
+
+    if (entry.pEntity == pEntity)
+    {
+        tNode& leaf = m_nodes[entry.leaf];
+        if (leaf.bounds == bounds)
+            return;
+
+        leaf.bounds = bounds;
+
+        // Refit in place while the leaf stays inside its parent, reinsert it otherwise
+        if ((leaf.parent == NO_NODE) || m_nodes[leaf.parent].bounds.contains(bounds))
+        {
+            refit(leaf.parent);
+            return;
+        }
+
+        removeLeaf(entry.leaf);
+        insertLeaf(entry.leaf);
+        return;
+    }
+
+    // The slot might still be used by an entity destroyed since
+    if (entry.pEntity)
+    {
+        removeLeaf(entry.leaf);
+        releaseNode(entry.leaf);
+    }
+    else
+    {
+        ++m_nbEntities;
+    }
+
+    unsigned int leaf = allocateNode();
+    m_nodes[leaf].bounds = bounds;
+    m_nodes[leaf].entry = index;
+
+    entry.pEntity = pEntity;
+    entry.leaf = leaf;
+
+    insertLeaf(leaf);
+}
+
+//-----------------------------------------------------------------------
+
+void BoundsHierarchy::_remove(Entity* pEntity)
+{
+    if (!contains(pEntity))
+        return;
+
+    tEntry& entry = m_entries[pEntity->getHandle().uiIndex];
+
+    removeLeaf(entry.leaf);
+    releaseNode(entry.leaf);
+
+    entry.pEntity = 0;
+    entry.leaf = NO_NODE;
+    --m_nbEntities;
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int BoundsHierarchy::allocateNode()
+{
+    unsigned int node;
+
+    if (m_freeNodes != NO_NODE)
+    {
+        node = m_freeNodes;
+        m_freeNodes = m_nodes[node].parent;
+    }
+    else
+    {
+        node = (unsigned int) m_nodes.size();
+        m_nodes.push_back(tNode());
+    }
+
+    m_nodes[node].parent = NO_NODE;
+    m_nodes[node].children[0] = NO_NODE;
+    m_nodes[node].children[1] = NO_NODE;
+    m_nodes[node].entry = NO_NODE;
+
+    return node;
+}
+
+//-----------------------------------------------------------------------
+
+void BoundsHierarchy::releaseNode(unsigned int node)
+{
+    m_nodes[node].parent = m_freeNodes;
+    m_freeNodes = node;
+}
+
+//-----------------------------------------------------------------------
+
+void BoundsHierarchy::insertLeaf(unsigned int leaf)
+{
+    if (m_root == NO_NODE)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = NO_NODE;
+        return;
+    }
+
+    // Find the best sibling: descend in the child whose area grows the least, until
+    // creating a new parent here is cheaper (surface area heuristic)
+    const tBounds bounds = m_nodes[leaf].bounds;
+    unsigned int sibling = m_root;
+
+    while (!isLeaf(sibling))
+    {
+        const tNode& node = m_nodes[sibling];
+
+        tBounds combined = node.bounds;
+        combined.merge(bounds);
+
+        Real area = node.bounds.getSurfaceArea();
+        Real combinedArea = combined.getSurfaceArea();
+
+        // Cost of creating a new parent for this node and the leaf
+        Real cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        Real inheritanceCost = 2.0f * (combinedArea - area);
+
+        Real childrenCosts[2];
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            const tNode& child = m_nodes[node.children[i]];
+
+            tBounds childBounds = child.bounds;
+            childBounds.merge(bounds);
+
+            childrenCosts[i] = childBounds.getSurfaceArea() + inheritanceCost;
+            if (child.children[0] != NO_NODE)
+                childrenCosts[i] -= child.bounds.getSurfaceArea();
+        }
+
+        if ((cost < childrenCosts[0]) && (cost < childrenCosts[1]))
+            break;
+
+        sibling = node.children[childrenCosts[0] < childrenCosts[1] ? 0 : 1];
+    }
+
+    // Create a new parent for the sibling and the leaf
+    unsigned int oldParent = m_nodes[sibling].parent;
+    unsigned int newParent = allocateNode();
+
+    tNode& parent = m_nodes[newParent];
+    parent.parent = oldParent;
+    parent.bounds = m_nodes[sibling].bounds;
+    parent.bounds.merge(bounds);
+    parent.children[0] = sibling;
+    parent.children[1] = leaf;
+
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent == NO_NODE)
+    {
+        m_root = newParent;
+        return;
+    }
+
+    tNode& grandParent = m_nodes[oldParent];
+    grandParent.children[grandParent.children[0] == sibling ? 0 : 1] = newParent;
+
+    refit(oldParent);
+}
+
+//-----------------------------------------------------------------------
+
+void BoundsHierarchy::removeLeaf(unsigned int leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = NO_NODE;
+        return;
+    }
+
+    // Replace the parent by the sibling of the leaf
+    unsigned int parent = m_nodes[leaf].parent;
+    unsigned int grandParent = m_nodes[parent].parent;
+    unsigned int sibling = m_nodes[parent].children[m_nodes[parent].children[0] == leaf ? 1 : 0];
+
+    m_nodes[sibling].parent = grandParent;
+    m_nodes[leaf].parent = NO_NODE;
+    releaseNode(parent);
+
+    if (grandParent == NO_NODE)
+    {
+        m_root = sibling;
+        return;
+    }
+
+    tNode& node = m_nodes[grandParent];
+    node.children[node.children[0] == parent ? 0 : 1] = sibling;
+
+    refit(grandParent);
+}
+
+//-----------------------------------------------------------------------
+
+void BoundsHierarchy::refit(unsigned int node)
+{
+    while (node != NO_NODE)
+    {
+        tNode& current = m_nodes[node];
+
+        tBounds bounds = m_nodes[current.children[0]].bounds;
+        bounds.merge(m_nodes[current.children[1]].bounds);
+
+        if (bounds == current.bounds)
+            return;
+
+        current.bounds = bounds;
+        node = current.parent;
+    }
+}
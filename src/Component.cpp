@@ -6,6 +6,7 @@
 
 #include <Athena-Entities/Component.h>
 #include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/ComponentsPool.h>
 #include <Athena-Entities/Entity.h>
 #include <Athena-Entities/Transforms.h>
 #include <Athena-Core/Utils/Variant.h>
@@ -23,11 +24,59 @@ using namespace std;
 // Type of component
 const std::string Component::TYPE = "Athena/Component";
 
+// Identifier of the type of component
+const Component::tTypeID Component::TYPE_ID = Component::_newTypeID();
+
+const Component::tTypeID Component::INVALID_TYPE_ID;
+
+
+/********************************** PRIVATE FUNCTIONS ***********************************/
+
+/// Informations about a type of component
+struct tTypeInfos
+{
+    const Component::tTypeID*   pParentTypeID;          ///< TYPE_ID of the parent class (0 if unknown)
+    bool                        bHasSubtypesWithoutID;  ///< Indicates if some subclasses share the identifier
+};
+
+/// Returns the informations about the types of components, indexed by their identifier
+static std::vector<tTypeInfos>& getTypesInfos()
+{
+    // Never destroyed: used during the static initialization and destruction
+    static std::vector<tTypeInfos>* pTypes = new std::vector<tTypeInfos>();
+    return *pTypes;
+}
+
+//-----------------------------------------------------------------------
+
+/// Returns the pool from which the links between the components are allocated
+static ComponentsPool* getLinksPool()
+{
+    // Never destroyed: components can still be destroyed during the destruction of the
+    // static objects
+    static ComponentsPool* pPool = new ComponentsPool(sizeof(Component::tLink),
+                                                      alignof(Component::tLink), 256);
+    return pPool;
+}
+
+
+//-----------------------------------------------------------------------
+
+/// Indicates if a component is destroyed at the same time as other entities (see
+/// Scene::destroy())
+static bool isBeingDestroyed(Component* pComponent)
+{
+    Entity* pEntity = pComponent->getList()->getEntity();
+    return (pEntity && pEntity->_isBeingDestroyed());
+}
+
 
 /***************************** CONSTRUCTION / DESTRUCTION *******************************/
 
 Component::Component(const std::string& strName, ComponentsList* pList)
-: m_id(COMP_OTHER, strName), m_pList(pList), m_pTransforms(0)
+: m_id(COMP_OTHER, strName), m_typeID(TYPE_ID), m_pList(pList), m_pLinksTo(0),
+  m_pLinksBy(0), m_pTransforms(0), m_pSignals(0), m_pSceneList(0), m_uiSceneIndex(0),
+  m_pPool(0)
 {
     // Assertions
     assert(!strName.empty() && "Invalid name");
@@ -44,8 +93,10 @@ Component::Component(const std::string& strName, ComponentsList* pList)
 Component::~Component()
 {
     // This was done by our managers
-    assert(m_linked_by.empty());
-    assert(m_linked_to.empty());
+    assert(!m_pLinksBy);
+    assert(!m_pLinksTo);
+
+    delete m_pSignals;
 }
 
 //-----------------------------------------------------------------------
@@ -55,6 +106,73 @@ Component* Component::create(const std::string& strName, ComponentsList* pList)
     return new Component(strName, pList);
 }
 
+//-----------------------------------------------------------------------
+
+Component::tTypeID Component::_newTypeID(const tTypeID* pParentTypeID)
+{
+    // Usable during the static initialization, whatever the order of the files (the
+    // parent types are only read later, hence their addresses)
+    std::vector<tTypeInfos>& types = getTypesInfos();
+
+    tTypeInfos infos;
+    infos.pParentTypeID = pParentTypeID;
+    infos.bHasSubtypesWithoutID = false;
+
+    types.push_back(infos);
+    return (tTypeID) types.size() - 1;
+}
+
+//-----------------------------------------------------------------------
+
+Component::tTypeID Component::_newSubtypeID(const tTypeID* pParentTypeID)
+{
+    // Assertions
+    assert(pParentTypeID);
+    assert(*pParentTypeID < getTypesInfos().size());
+
+    // The components of the subclass created outside of the manager keep the identifier
+    // of the parent class
+    getTypesInfos()[*pParentTypeID].bHasSubtypesWithoutID = true;
+
+    return _newTypeID(pParentTypeID);
+}
+
+//-----------------------------------------------------------------------
+
+bool Component::_isDerivedType(tTypeID typeID, tTypeID baseTypeID, bool& bUnknown)
+{
+    const std::vector<tTypeInfos>& types = getTypesInfos();
+
+    bUnknown = false;
+
+    if ((typeID >= types.size()) || (baseTypeID >= types.size()))
+    {
+        bUnknown = true;
+        return false;
+    }
+
+    const bool bShared = types[typeID].bHasSubtypesWithoutID;
+
+    while (typeID != baseTypeID)
+    {
+        if (typeID == TYPE_ID)
+        {
+            bUnknown = bShared;
+            return false;
+        }
+
+        if (!types[typeID].pParentTypeID)
+        {
+            bUnknown = true;
+            return false;
+        }
+
+        typeID = *types[typeID].pParentTypeID;
+    }
+
+    return true;
+}
+
 
 /*************************** MANAGEMENT OF THE TRANSFORMATIONS **************************/
 
@@ -64,6 +182,7 @@ void Component::setTransforms(Transforms* pTransforms)
     assert(m_pList);
 
     // Unlink from the current transforms
+    bool bHadTransforms = (m_pTransforms != 0);
     if (m_pTransforms)
     {
         removeLinkTo(m_pTransforms);
@@ -88,12 +207,11 @@ void Component::setTransforms(Transforms* pTransforms)
     m_pTransforms = pNewTransforms;
 
     if (m_pTransforms)
-    {
         addLinkTo(m_pTransforms);
 
-        // Do whatever we must do when our transforms change
+    // Do whatever we must do when our transforms change
+    if (m_pTransforms || bHadTransforms)
         onTransformsChanged();
-    }
 }
 
 //-----------------------------------------------------------------------
@@ -143,13 +261,107 @@ void Component::mustUnlinkComponent(Component* pComponent)
 
 void Component::unlink()
 {
-    // Tell all the components linked to this one to unlink it
-    while (!m_linked_by.empty())
-        m_linked_by.front()->mustUnlinkComponent(this);
+    // Tell all the components linked to this one to unlink it (the ones destroyed at the
+    // same time just forget it)
+    while (m_pLinksBy)
+    {
+        Component* pComponent = m_pLinksBy->pFrom;
+
+        if (isBeingDestroyed(pComponent))
+        {
+            if (pComponent->m_pTransforms == this)
+                pComponent->m_pTransforms = 0;
+
+            pComponent->releaseLink(m_pLinksBy);
+        }
+        else
+        {
+            pComponent->mustUnlinkComponent(this);
+        }
+    }
+
+    // Unlink all the components we are linked with (if this one is destroyed with its
+    // entity, there is no need to do anything else than releasing the links)
+    if (m_pLinksTo && isBeingDestroyed(this))
+    {
+        m_pTransforms = 0;
+
+        while (m_pLinksTo)
+            releaseLink(m_pLinksTo);
+    }
+
+    while (m_pLinksTo)
+        mustUnlinkComponent(m_pLinksTo->pTo);
+}
+
+//-----------------------------------------------------------------------
+
+void Component::addLinkTo(Component* pComponent)
+{
+    // Assertions
+    assert(pComponent);
+
+    tLink* pLink = static_cast<tLink*>(getLinksPool()->allocate());
+
+    pLink->pFrom = this;
+    pLink->pTo = pComponent;
+
+    // Insert it at the beginning of both lists
+    pLink->pPrevTo = 0;
+    pLink->pNextTo = m_pLinksTo;
+    if (m_pLinksTo)
+        m_pLinksTo->pPrevTo = pLink;
+    m_pLinksTo = pLink;
+
+    pLink->pPrevBy = 0;
+    pLink->pNextBy = pComponent->m_pLinksBy;
+    if (pComponent->m_pLinksBy)
+        pComponent->m_pLinksBy->pPrevBy = pLink;
+    pComponent->m_pLinksBy = pLink;
+}
+
+//-----------------------------------------------------------------------
+
+void Component::removeLinkTo(Component* pComponent)
+{
+    // Assertions
+    assert(pComponent);
+
+    // Search the link
+    tLink* pLink = m_pLinksTo;
+    while (pLink && (pLink->pTo != pComponent))
+        pLink = pLink->pNextTo;
+
+    if (pLink)
+        releaseLink(pLink);
+}
+
+//-----------------------------------------------------------------------
+
+void Component::releaseLink(tLink* pLink)
+{
+    // Assertions
+    assert(pLink);
+    assert(pLink->pFrom == this);
+
+    // Remove it from both lists
+    if (pLink->pPrevTo)
+        pLink->pPrevTo->pNextTo = pLink->pNextTo;
+    else
+        m_pLinksTo = pLink->pNextTo;
+
+    if (pLink->pNextTo)
+        pLink->pNextTo->pPrevTo = pLink->pPrevTo;
+
+    if (pLink->pPrevBy)
+        pLink->pPrevBy->pNextBy = pLink->pNextBy;
+    else
+        pLink->pTo->m_pLinksBy = pLink->pNextBy;
+
+    if (pLink->pNextBy)
+        pLink->pNextBy->pPrevBy = pLink->pPrevBy;
 
-    // Unlink all the components we are linked with
-    while (!m_linked_to.empty())
-        mustUnlinkComponent(m_linked_to.front());
+    getLinksPool()->release(pLink);
 }
 
 
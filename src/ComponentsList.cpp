@@ -9,6 +9,7 @@
 #include <Athena-Entities/ComponentsManager.h>
 #include <Athena-Entities/Entity.h>
 #include <Athena-Entities/Scene.h>
+#include <algorithm>
 
 
 using namespace Athena;
@@ -41,6 +42,15 @@ bool ComponentsList::_addComponent(Component* pComponent)
         return false;
 
     m_components.push_back(pComponent);
+    m_index[pComponent->getID().strName].push_back(pComponent);
+
+    // Register it in the scene
+    Scene* pScene = m_pScene;
+    if (!pScene && m_pEntity)
+        pScene = m_pEntity->getScene();
+
+    if (pScene)
+        pScene->_registerComponent(pComponent);
 
     return true;
 }
@@ -57,6 +67,25 @@ void ComponentsList::_removeComponent(Component* pComponent)
     pComponent->removeTransforms();
     pComponent->unlink();
 
+    // Unregister it from the scene
+    Scene* pScene = m_pScene;
+    if (!pScene && m_pEntity)
+        pScene = m_pEntity->getScene();
+
+    if (pScene)
+        pScene->_unregisterComponent(pComponent);
+
+    // Remove it from the index
+    tComponentsIndex::iterator iterIndex = m_index.find(pComponent->getID().strName);
+    if (iterIndex != m_index.end())
+    {
+        Component::tComponentsList& components = iterIndex->second;
+        components.erase(std::find(components.begin(), components.end(), pComponent));
+
+        if (components.empty())
+            m_index.erase(iterIndex);
+    }
+
     // Remove it from the list
     Component::tComponentsList::iterator iter, iterEnd;
     for (iter = m_components.begin(), iterEnd = m_components.end(); iter != iterEnd; ++iter)
@@ -71,20 +100,34 @@ void ComponentsList::_removeComponent(Component* pComponent)
 
 //-----------------------------------------------------------------------
 
-void ComponentsList::removeAllComponents()
+void ComponentsList::removeAllComponents(Component* pKept)
 {
-    // Unlink all the components
+    // Unlink all the components (when the entity is destroyed with others, the links
+    // between their components are just released, see Component::unlink())
+    bool bBeingDestroyed = (m_pEntity && m_pEntity->_isBeingDestroyed());
+
     Component::tComponentsIterator iter(m_components.begin(), m_components.end());
     while (iter.hasMoreElements())
     {
         Component* pComponent = iter.getNext();
-        pComponent->removeTransforms();
+
+        if (!bBeingDestroyed)
+            pComponent->removeTransforms();
+
         pComponent->unlink();
     }
 
     // Destroy the components
-    while (!m_components.empty())
-        ComponentsManager::getSingletonPtr()->destroy(m_components.front());
+    while (m_components.size() > (pKept ? 1 : 0))
+    {
+        Component* pComponent = m_components.front();
+        if (pComponent == pKept)
+            pComponent = m_components[1];
+
+        ComponentsManager::getSingletonPtr()->destroy(pComponent);
+    }
+
+    assert(!pKept || (m_components.front() == pKept));
 }
 
 //-----------------------------------------------------------------------
@@ -95,15 +138,17 @@ Component* ComponentsList::getComponent(const tComponentID& id, bool bInAllScene
     // name of the entity owning this list)
     if (id.strEntity.empty() || (m_pEntity && (id.strEntity == m_pEntity->getName())))
     {
-        Component::tComponentsList::const_iterator iter, iterEnd;
-        for (iter = m_components.begin(), iterEnd = m_components.end(); iter != iterEnd; ++iter)
+        tComponentsIndex::const_iterator iterIndex = m_index.find(id.strName);
+        if (iterIndex != m_index.end())
         {
-            tComponentID compID = (*iter)->getID();
-
-            if ((compID == id) ||
-                (id.strEntity.empty() && (compID.type == id.type) && (compID.strName == id.strName)))
+            Component::tComponentsList::const_iterator iter, iterEnd;
+            for (iter = iterIndex->second.begin(), iterEnd = iterIndex->second.end();
+                 iter != iterEnd; ++iter)
             {
-                return *iter;
+                const tComponentID& compID = (*iter)->getID();
+
+                if ((compID == id) || (id.strEntity.empty() && (compID.type == id.type)))
+                    return *iter;
             }
         }
     }
@@ -88,23 +88,54 @@ Component* ComponentsManager::create(const std::string& strType, const std::stri
     assert(!strName.empty() && "Invalid component name");
     assert(pList && "Invalid list");
 
-    // Declarations
-    Component* pComponent = 0;
+    // Search the creation infos of the type
+    tCreationsInfosNativeIterator iter = m_types.find(strType);
+    if (iter == m_types.end())
+    {
+        ATHENA_LOG_ERROR("Failed to create the component '" + strName + "': unknown component type (" + strType + ")");
+        return 0;
+    }
+
+    return create(iter->second, strName, pList);
+}
+
+//-----------------------------------------------------------------------
 
-    ATHENA_LOG_DEBUG("Creating a new component of type '" + strType + "' with the name '" + strName + "'");
+Component* ComponentsManager::create(Component::tTypeID typeID, const std::string& strName,
+                                     ComponentsList* pList)
+{
+    // Assertions
+    assert(!strName.empty() && "Invalid component name");
+    assert(pList && "Invalid list");
 
     // Search the creation infos of the type
-    if (m_types.find(strType) != m_types.end())
+    ComponentCreationInfos* pInfos = getCreationInfos(typeID);
+    if (!pInfos)
     {
-        // Use them to create the component
-        pComponent = m_types[strType]->create(strName, pList);
-        if (!pComponent)
-            ATHENA_LOG_ERROR("Failed to create a component of type '" + strType + "' with the name '" + strName + "'");
+        ATHENA_LOG_ERROR("Failed to create the component '" + strName + "': unknown component type");
+        return 0;
     }
-    else
+
+    return create(pInfos, strName, pList);
+}
+
+//-----------------------------------------------------------------------
+
+Component* ComponentsManager::create(ComponentCreationInfos* pInfos,
+                                     const std::string& strName, ComponentsList* pList)
+{
+    // Assertions
+    assert(pInfos);
+
+    Component* pComponent = pInfos->create(strName, pList);
+    if (pComponent)
     {
-        ATHENA_LOG_ERROR("Failed to create the component '" + strName + "': unknown component type (" + strType + ")");
+        // The class of the component might not declare its own TYPE_ID
+        pComponent->m_typeID = pInfos->typeID;
+        pComponent->m_pPool = pInfos->pPool;
     }
+    else
+        ATHENA_LOG_ERROR("Failed to create a component of type '" + pInfos->strType + "' with the name '" + strName + "'");
 
     return pComponent;
 }
@@ -115,16 +146,29 @@ void ComponentsManager::destroy(Component* pComponent)
 {
     // Assertions
     assert(pComponent && "Invalid component");
-    assert(m_types.find(pComponent->getType()) != m_types.end());
+    assert(getCreationInfos(pComponent->getTypeID()) && "Unknown type of component");
 
-    // Fire a 'component destroyed' signal
-    pComponent->getSignalsList()->fire(SIGNAL_COMPONENT_DESTROYED);
+    // Fire a 'component destroyed' signal (if someone listens to it)
+    if (pComponent->m_pSignals)
+        pComponent->m_pSignals->fire(SIGNAL_COMPONENT_DESTROYED);
 
     // Remove the component form its list
     pComponent->getList()->_removeComponent(pComponent);
 
     // Actual destruction
-    delete pComponent;
+    ComponentsPool* pPool = pComponent->m_pPool;
+    if (pPool)
+    {
+        // The address of the memory block is the one of the most derived object
+        void* pMemory = dynamic_cast<void*>(pComponent);
+
+        pComponent->~Component();
+        pPool->release(pMemory);
+    }
+    else
+    {
+        delete pComponent;
+    }
 }
 
 //-----------------------------------------------------------------------
@@ -137,10 +181,11 @@ v8::Handle<v8::Value> ComponentsManager::convertToJavaScript(Component* pCompone
     assert(pComponent);
 
     // Search the creation infos of the type
-    if (m_types.find(pComponent->getType()) != m_types.end())
+    ComponentCreationInfos* pInfos = getCreationInfos(pComponent->getTypeID());
+    if (pInfos)
     {
         // Use them to wrap the component
-        return m_types[pComponent->getType()]->convertToJavaScript(pComponent);
+        return pInfos->convertToJavaScript(pComponent);
     }
 
     // Type not found, return a basic component
@@ -148,3 +193,67 @@ v8::Handle<v8::Value> ComponentsManager::convertToJavaScript(Component* pCompone
 }
 
 #endif
+
+
+/*********************** REGISTRATION OF NEW TYPES OF COMPONENTS ************************/
+
+Component::tTypeID ComponentsManager::registerType(const std::string& strType,
+                                                   const Component::tTypeID* pTypeID,
+                                                   ComponentCreationInfos* pInfos)
+{
+    // Assertions
+    assert(!strType.empty() && "Invalid type name");
+    assert(pTypeID);
+    assert(pInfos);
+
+    ATHENA_LOG_EVENT("Registering a new type of component: '" + strType + "'");
+
+    // Search if the type is already defined
+    if (m_types.find(strType) != m_types.end())
+    {
+        ATHENA_LOG_ERROR("The type of component '" + strType + "' was already registered");
+        delete pInfos;
+        return Component::INVALID_TYPE_ID;
+    }
+
+    // A class which doesn't declare its own TYPE_ID inherits the one of its parent
+    // class: give it a new one (assigned to its components at creation), whose parent
+    // is the type of that class
+    Component::tTypeID typeID = *pTypeID;
+    if (getCreationInfos(typeID))
+        typeID = Component::_newSubtypeID(pTypeID);
+
+    pInfos->strType = strType;
+    pInfos->typeID = typeID;
+
+    m_types[strType] = pInfos;
+
+    if (typeID >= m_typesByID.size())
+        m_typesByID.resize(typeID + 1, 0);
+
+    m_typesByID[typeID] = pInfos;
+
+    return typeID;
+}
+
+//-----------------------------------------------------------------------
+
+ComponentsPool* ComponentsManager::getPool(const std::string& strType)
+{
+    tCreationsInfosNativeIterator iter = m_types.find(strType);
+    if (iter == m_types.end())
+        return 0;
+
+    return iter->second->pPool;
+}
+
+//-----------------------------------------------------------------------
+
+Component::tTypeID ComponentsManager::getTypeID(const std::string& strType) const
+{
+    tCreationsInfosList::const_iterator iter = m_types.find(strType);
+    if (iter == m_types.end())
+        return Component::INVALID_TYPE_ID;
+
+    return iter->second->typeID;
+}
@@ -0,0 +1,102 @@
+/** @file   ComponentsPool.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::ComponentsPool'
+*/
+
+#include <Athena-Entities/ComponentsPool.h>
+#include <algorithm>
+#include <cstddef>
+
+using namespace Athena::Entities;
+using namespace std;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+ComponentsPool::ComponentsPool(size_t size, size_t alignment, unsigned int nbObjectsPerSlab)
+: m_blockSize(0), m_nbObjectsPerSlab(nbObjectsPerSlab), m_pFreeList(0), m_nbObjects(0),
+  m_uiHighWaterMark(0)
+{
+    // Assertions
+    assert(size > 0);
+    assert(nbObjectsPerSlab > 0);
+    assert(alignment > 0 && ((alignment & (alignment - 1)) == 0));
+
+    // The slabs are allocated by 'operator new', which aligns them for any fundamental type
+    assert(alignment <= alignof(max_align_t));
+
+    // A free block contains the pointer to the next one
+    if (alignment < sizeof(void*))
+        alignment = sizeof(void*);
+
+    m_blockSize = (max(size, sizeof(void*)) + alignment - 1) & ~(alignment - 1);
+}
+
+//-----------------------------------------------------------------------
+
+ComponentsPool::~ComponentsPool()
+{
+    assert(m_nbObjects == 0 && "Some objects weren't released");
+
+    for (unsigned int i = 0; i < m_slabs.size(); ++i)
+        delete[] m_slabs[i];
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void* ComponentsPool::allocate()
+{
+    if (!m_pFreeList)
+        addSlab();
+
+    void* pObject = m_pFreeList;
+    m_pFreeList = *((void**) pObject);
+
+    ++m_nbObjects;
+    if (m_nbObjects > m_uiHighWaterMark)
+        m_uiHighWaterMark = m_nbObjects;
+
+    return pObject;
+}
+
+//-----------------------------------------------------------------------
+
+void ComponentsPool::release(void* pObject)
+{
+    // Assertions
+    assert(pObject);
+    assert(m_nbObjects > 0);
+
+    // The last released block is the first reused one: it is probably still in the cache
+    *((void**) pObject) = m_pFreeList;
+    m_pFreeList = pObject;
+
+    --m_nbObjects;
+}
+
+//-----------------------------------------------------------------------
+
+void ComponentsPool::reserve(unsigned int nbObjects)
+{
+    while (getCapacity() < nbObjects)
+        addSlab();
+}
+
+//-----------------------------------------------------------------------
+
+void ComponentsPool::addSlab()
+{
+    char* pSlab = new char[m_blockSize * m_nbObjectsPerSlab];
+    m_slabs.push_back(pSlab);
+
+    // Chain the blocks in memory order, in front of the current free-list
+    for (unsigned int i = 0; i < m_nbObjectsPerSlab; ++i)
+    {
+        void* pNext = (i + 1 < m_nbObjectsPerSlab ? pSlab + (i + 1) * m_blockSize : m_pFreeList);
+        *((void**) (pSlab + i * m_blockSize)) = pNext;
+    }
+
+    m_pFreeList = pSlab;
+}
@@ -8,11 +8,13 @@
 #include <Athena-Entities/Scene.h>
 #include <Athena-Entities/AnimationsMixer.h>
 #include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/TransformsStore.h>
 #include <Athena-Entities/Signals.h>
 #include <Athena-Core/Log/LogManager.h>
 
 
 using namespace Athena::Entities;
+using namespace Athena::Math;
 using namespace Athena::Signals;
 using namespace Athena::Utils;
 using namespace Athena::Log;
@@ -28,8 +30,10 @@ static const char*  __CONTEXT__ = "Entity";
 /***************************** CONSTRUCTION / DESTRUCTION *******************************/
 
 Entity::Entity(const std::string& strName, Scene* pScene, Entity* pParent)
-: m_strName(strName), m_pScene(pScene), m_pParent(0), m_bEnabled(true),
-  m_pAnimationsMixer(0), m_pTransforms(0)
+: m_strName(strName), m_pScene(pScene), m_uiIndex(0), m_pParent(0), m_bEnabled(true),
+  m_bBeingDestroyed(false), m_pSignals(0),
+  m_pAnimationsMixer(0), m_pTransforms(0), m_bHasBounds(false), m_pArchetype(0),
+  m_uiArchetypeIndex(0), m_bUnclassified(false)
 {
     // Assertions
     assert(!strName.empty() && "Invalid name");
@@ -47,6 +51,28 @@ Entity::Entity(const std::string& strName, Scene* pScene, Entity* pParent)
 
 //-----------------------------------------------------------------------
 
+Entity::Entity(Scene* pScene)
+: m_pScene(0), m_uiIndex(0), m_pParent(0), m_bEnabled(true), m_bBeingDestroyed(false),
+  m_pSignals(0), m_pAnimationsMixer(0),
+  m_pTransforms(0), m_bHasBounds(false), m_pArchetype(0), m_uiArchetypeIndex(0),
+  m_bUnclassified(false)
+{
+    // Assertions
+    assert(pScene);
+
+    // Initializations
+    m_components._setEntity(this);
+
+    // The transforms don't use a slot of the store of the scene until the entity is
+    // used, so they aren't processed with the ones of the scene
+    m_pTransforms = new Transforms("Transforms", &m_components);
+    m_pTransforms->_park(pScene->getTransformsStore());
+
+    m_pScene = pScene;
+}
+
+//-----------------------------------------------------------------------
+
 Entity::~Entity()
 {
     // Destroy the animations mixer
@@ -67,6 +93,80 @@ Entity::~Entity()
     }
 
     m_components.removeAllComponents();
+
+    delete m_pSignals;
+}
+
+//-----------------------------------------------------------------------
+
+void Entity::recycle()
+{
+    // Destroy the animations mixer
+    if (m_pAnimationsMixer)
+    {
+        delete m_pAnimationsMixer;
+        m_pAnimationsMixer = 0;
+    }
+
+    // Forget the children, the scene destroys them at the same time
+    for (unsigned int i = 0; i < m_children.size(); ++i)
+        m_children[i]->m_pParent = 0;
+
+    m_children.clear();
+
+    // Notify the parent that this entity is destroyed (unless it is destroyed too)
+    if (m_pParent)
+    {
+        if (!m_pParent->m_bBeingDestroyed)
+            m_pParent->removeChild(this);
+
+        m_pParent = 0;
+    }
+
+    // Destroy all the components, except the transforms (the listeners must still be
+    // notified of their destruction)
+    if (m_pTransforms->m_pSignals)
+        m_pTransforms->m_pSignals->fire(SIGNAL_COMPONENT_DESTROYED);
+
+    m_components.removeAllComponents(m_pTransforms);
+
+    // Disconnect all the listeners (the signals lists are created again when needed)
+    delete m_pSignals;
+    m_pSignals = 0;
+
+    delete m_pTransforms->m_pSignals;
+    m_pTransforms->m_pSignals = 0;
+
+    // Release the slot of the transforms in the store of the scene (reused by the next
+    // entities)
+    m_pScene->_unregisterComponent(m_pTransforms);
+    m_pTransforms->_park(m_pScene->getTransformsStore());
+
+    m_strName.clear();
+    m_pTransforms->m_id.strEntity = tSymbol();
+    m_bEnabled = true;
+    m_bHasBounds = false;
+}
+
+//-----------------------------------------------------------------------
+
+void Entity::reuse(const std::string& strName, Entity* pParent)
+{
+    // Assertions
+    assert(!strName.empty() && "Invalid name");
+    assert(m_strName.empty() && "The entity wasn't recycled");
+
+    m_strName = strName;
+    m_pTransforms->m_id.strEntity = strName;
+
+    // Allocate a new slot (with identity transforms) for the transforms in the store of
+    // the scene
+    m_pScene->_registerComponent(m_pTransforms);
+    m_pTransforms->_unpark();
+
+    // If a parent was specified, ask it to add this entity in its children's list
+    if (pParent)
+        pParent->addChild(this);
 }
 
 
@@ -79,10 +179,13 @@ void Entity::enable(bool bEnabled)
 
     m_bEnabled = bEnabled;
 
+    if (!m_pSignals)
+        return;
+
     if (m_bEnabled)
-        m_signals.fire(SIGNAL_ENTITY_ENABLED, new Variant(getName()));
+        m_pSignals->fire(SIGNAL_ENTITY_ENABLED, new Variant(getName()));
     else
-        m_signals.fire(SIGNAL_ENTITY_DISABLED, new Variant(getName()));
+        m_pSignals->fire(SIGNAL_ENTITY_DISABLED, new Variant(getName()));
 }
 
 
@@ -111,17 +214,15 @@ void Entity::removeChild(Entity* pChild)
     // Assertions
     assert(pChild && "Invalid child");
 
-    // Declarations
-    tEntitiesNativeIterator iter, iterEnd;
-
-    // Remove the child from the list of this entity
-    for (iter = m_children.begin(), iterEnd = m_children.end(); iter != iterEnd; ++iter)
+    // Remove the child from the list of this entity (starting from the end, the last
+    // children are removed first by destroyAllChildren())
+    for (unsigned int i = (unsigned int) m_children.size(); i > 0; --i)
     {
-        if (*iter == pChild)
+        if (m_children[i - 1] == pChild)
         {
-            (*iter)->m_pParent = 0;
-            (*iter)->getTransforms()->removeTransforms();
-            m_children.erase(iter);
+            pChild->m_pParent = 0;
+            pChild->getTransforms()->removeTransforms();
+            m_children.erase(m_children.begin() + (i - 1));
             return;
         }
     }
@@ -156,7 +257,31 @@ void Entity::destroyAllChildren()
 {
     // Destroy the children
     while (!m_children.empty())
-        m_pScene->destroy(m_children.front());
+        m_pScene->destroy(m_children.back());
+}
+
+
+/****************************** MANAGEMENT OF THE BOUNDS ********************************/
+
+void Entity::setBounds(const tBounds& bounds)
+{
+    m_bounds = bounds;
+    m_bHasBounds = true;
+
+    // Notify the scene through the store of the transforms (see Scene::castRay())
+    m_pTransforms->getStore()->_trackChange(m_pTransforms->getStoreIndex());
+}
+
+//-----------------------------------------------------------------------
+
+void Entity::removeBounds()
+{
+    if (!m_bHasBounds)
+        return;
+
+    m_bHasBounds = false;
+
+    m_pTransforms->getStore()->_trackChange(m_pTransforms->getStoreIndex());
 }
 
 
@@ -0,0 +1,78 @@
+/** @file   HandlesTable.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::HandlesTable'
+*/
+
+#include <Athena-Entities/HandlesTable.h>
+
+using namespace Athena::Entities;
+using namespace std;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+HandlesTable::HandlesTable()
+{
+}
+
+//-----------------------------------------------------------------------
+
+HandlesTable::~HandlesTable()
+{
+}
+
+
+/*************************************** METHODS ****************************************/
+
+tHandle HandlesTable::allocate(void* pObject)
+{
+    // Assertions
+    assert(pObject);
+
+    // Reuse a released slot if possible
+    if (!m_freeSlots.empty())
+    {
+        unsigned int index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+
+        m_slots[index].pObject = pObject;
+
+        return tHandle(index, m_slots[index].uiGeneration);
+    }
+
+    tSlot slot;
+    slot.pObject = pObject;
+    slot.uiGeneration = 1;
+
+    m_slots.push_back(slot);
+
+    return tHandle((unsigned int) m_slots.size() - 1, slot.uiGeneration);
+}
+
+//-----------------------------------------------------------------------
+
+void HandlesTable::release(const tHandle& handle)
+{
+    // Assertions
+    assert(get(handle) && "Invalid handle");
+
+    tSlot& slot = m_slots[handle.uiIndex];
+
+    slot.pObject = 0;
+
+    // The generation 0 is reserved to the invalid handles
+    ++slot.uiGeneration;
+    if (slot.uiGeneration == 0)
+        slot.uiGeneration = 1;
+
+    m_freeSlots.push_back(handle.uiIndex);
+}
+
+//-----------------------------------------------------------------------
+
+void HandlesTable::reserve(unsigned int nbObjects)
+{
+    m_slots.reserve(nbObjects);
+    m_freeSlots.reserve(nbObjects);
+}
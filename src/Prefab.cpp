@@ -0,0 +1,258 @@
+/** @file   Prefab.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::Prefab'
+*/
+
+#include <Athena-Entities/Prefab.h>
+#include <Athena-Entities/ComponentsManager.h>
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Scene.h>
+#include <Athena-Entities/Transforms.h>
+#include <Athena-Core/Utils/PropertiesList.h>
+#include <map>
+
+using namespace Athena::Entities;
+using namespace Athena::Utils;
+using namespace std;
+
+
+/************************************** CONSTANTS ***************************************/
+
+const unsigned int Prefab::NO_LINK;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+Prefab::Prefab()
+{
+}
+
+//-----------------------------------------------------------------------
+
+Prefab::Prefab(Entity* pEntity)
+{
+    compile(pEntity);
+}
+
+//-----------------------------------------------------------------------
+
+Prefab::~Prefab()
+{
+    clear();
+}
+
+
+/*************************************** METHODS ****************************************/
+
+void Prefab::compile(Entity* pEntity)
+{
+    // Assertions
+    assert(pEntity);
+
+    clear();
+
+    // Declarations
+    std::map<Component*, unsigned int> indices;
+    std::vector<Component*> sources;
+    std::vector<std::pair<Entity*, unsigned int> > stack;
+
+    // Go through the hierarchy depth-first, so each entity comes after its parent
+    stack.push_back(make_pair(pEntity, NO_LINK));
+
+    while (!stack.empty())
+    {
+        Entity* pCurrent = stack.back().first;
+
+        tEntity entity;
+        entity.strName = pCurrent->getName();
+        entity.parent = stack.back().second;
+        entity.firstComponent = (unsigned int) m_components.size();
+        entity.nbComponents = 0;
+        entity.bEnabled = pCurrent->isEnabled();
+        entity.bHasBounds = pCurrent->hasBounds();
+        entity.bounds = pCurrent->getBounds();
+
+        stack.pop_back();
+
+        // The Transforms of the entity first, then its other components
+        std::vector<Component*> components;
+        components.push_back(pCurrent->getTransforms());
+
+        Component::tComponentsIterator compIter = pCurrent->getComponentsIterator();
+        while (compIter.hasMoreElements())
+        {
+            Component* pComponent = compIter.getNext();
+            if (pComponent != pCurrent->getTransforms())
+                components.push_back(pComponent);
+        }
+
+        for (unsigned int i = 0; i < components.size(); ++i)
+        {
+            Component* pComponent = components[i];
+
+            tComponent component;
+            component.typeID = pComponent->getTypeID();
+            component.strName = pComponent->getName();
+            component.transforms = NO_LINK;
+            component.firstProperty = (unsigned int) m_properties.size();
+
+            // Copy the properties, except the link to the Transforms (remapped below)
+            PropertiesList* pProperties = pComponent->getProperties();
+
+            PropertiesList::tCategoriesIterator categIter = pProperties->getCategoriesIterator();
+            while (categIter.hasMoreElements())
+            {
+                PropertiesList::tCategory* pCategory = categIter.peekNextPtr();
+                categIter.moveNext();
+
+                PropertiesList::tPropertiesList::iterator propIter, propIterEnd;
+                for (propIter = pCategory->values.begin(), propIterEnd = pCategory->values.end();
+                     propIter != propIterEnd; ++propIter)
+                {
+                    if ((pCategory->strName == Component::TYPE) && (propIter->strName == "transforms"))
+                        continue;
+
+                    tProperty property;
+                    property.strCategory = pCategory->strName;
+                    property.strName = propIter->strName;
+                    property.pValue = new Variant(*(propIter->pValue));
+
+                    m_properties.push_back(property);
+                }
+            }
+
+            delete pProperties;
+
+            component.nbProperties = (unsigned int) m_properties.size() - component.firstProperty;
+
+            indices[pComponent] = (unsigned int) m_components.size();
+            sources.push_back(pComponent);
+            m_components.push_back(component);
+        }
+
+        entity.nbComponents = (unsigned int) components.size();
+
+        // Push the children in reverse order, so they are compiled in order
+        unsigned int index = (unsigned int) m_entities.size();
+        m_entities.push_back(entity);
+
+        for (unsigned int i = pCurrent->getNbChildren(); i > 0; --i)
+            stack.push_back(make_pair(pCurrent->getChild(i - 1), index));
+    }
+
+    // Remap the links to the Transforms components of the hierarchy
+    for (unsigned int i = 0; i < sources.size(); ++i)
+    {
+        Transforms* pTarget = sources[i]->getTransforms();
+        if (!pTarget)
+            continue;
+
+        std::map<Component*, unsigned int>::iterator iter = indices.find(pTarget);
+        if (iter != indices.end())
+            m_components[i].transforms = iter->second;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void Prefab::clear()
+{
+    for (unsigned int i = 0; i < m_properties.size(); ++i)
+        delete m_properties[i].pValue;
+
+    m_entities.clear();
+    m_components.clear();
+    m_properties.clear();
+}
+
+//-----------------------------------------------------------------------
+
+Entity* Prefab::instantiate(const std::string& strName, Scene* pScene, Entity* pParent) const
+{
+    // Assertions
+    assert(!strName.empty() && "Invalid name");
+    assert(pScene);
+    assert(!isEmpty() && "The prefab is empty");
+    assert(ComponentsManager::getSingletonPtr());
+
+    // Declarations
+    ComponentsManager* pManager = ComponentsManager::getSingletonPtr();
+    std::vector<Entity*> entities(m_entities.size());
+    std::vector<Component*> components(m_components.size());
+
+    // Create the entities and their components (by type identifier, without lookup)
+    for (unsigned int i = 0; i < m_entities.size(); ++i)
+    {
+        const tEntity& entity = m_entities[i];
+
+        Entity* pEntity;
+        if (i == 0)
+            pEntity = pScene->create(strName, pParent);
+        else
+            pEntity = pScene->create(strName + "." + entity.strName, entities[entity.parent]);
+
+        entities[i] = pEntity;
+        components[entity.firstComponent] = pEntity->getTransforms();
+
+        for (unsigned int j = entity.firstComponent + 1;
+             j < entity.firstComponent + entity.nbComponents; ++j)
+        {
+            components[j] = pManager->create(m_components[j].typeID, m_components[j].strName,
+                                             pEntity->getComponentsList());
+        }
+    }
+
+    // Restore the links to the Transforms components (the ones of the entities are already
+    // linked to the Transforms of their parent)
+    for (unsigned int i = 0; i < m_entities.size(); ++i)
+    {
+        const tEntity& entity = m_entities[i];
+
+        for (unsigned int j = entity.firstComponent;
+             j < entity.firstComponent + entity.nbComponents; ++j)
+        {
+            if (!components[j])
+                continue;
+
+            unsigned int link = m_components[j].transforms;
+
+            if ((j == entity.firstComponent) &&
+                ((i == 0) || (link == m_entities[entity.parent].firstComponent)))
+            {
+                continue;
+            }
+
+            components[j]->setTransforms(link != NO_LINK ? Transforms::cast(components[link]) : 0);
+        }
+    }
+
+    // Apply the properties
+    for (unsigned int i = 0; i < m_components.size(); ++i)
+    {
+        if (!components[i])
+            continue;
+
+        const tComponent& component = m_components[i];
+
+        for (unsigned int j = component.firstProperty;
+             j < component.firstProperty + component.nbProperties; ++j)
+        {
+            const tProperty& property = m_properties[j];
+            components[i]->setProperty(property.strCategory, property.strName,
+                                       new Variant(*property.pValue));
+        }
+    }
+
+    // Bounds and state of the entities
+    for (unsigned int i = 0; i < m_entities.size(); ++i)
+    {
+        if (m_entities[i].bHasBounds)
+            entities[i]->setBounds(m_entities[i].bounds);
+
+        if (!m_entities[i].bEnabled)
+            entities[i]->enable(false);
+    }
+
+    return entities[0];
+}
@@ -8,16 +8,19 @@
 #include <Athena-Entities/ScenesManager.h>
 #include <Athena-Entities/Entity.h>
 #include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/Transforms.h>
 #include <Athena-Entities/Signals.h>
 #include <Athena-Core/Utils/PropertiesList.h>
 #include <Athena-Core/Log/LogManager.h>
 #include <memory.h>
+#include <algorithm>
 
 
 using namespace Athena::Entities;
 using namespace Athena::Signals;
 using namespace Athena::Utils;
 using namespace Athena::Log;
+using namespace Athena::Math;
 using namespace std;
 
 
@@ -27,10 +30,89 @@ using namespace std;
 static const char* __CONTEXT__ = "Scene";
 
 
+/********************************** PRIVATE FUNCTIONS ***********************************/
+
+/// Move the components of an entity from a scene to another one (their registration by
+/// type, and the data of the Transforms components)
+static void moveComponents(Entity* pEntity, Scene* pSrcScene, Scene* pDstScene)
+{
+    Component::tComponentsIterator iter = pEntity->getComponentsIterator();
+    while (iter.hasMoreElements())
+    {
+        Component* pComponent = iter.getNext();
+
+        pSrcScene->_unregisterComponent(pComponent);
+        pDstScene->_registerComponent(pComponent);
+
+        Transforms* pTransforms = Transforms::cast(pComponent);
+        if (pTransforms)
+            pTransforms->_setStore(pDstScene->getTransformsStore());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+/// A component of an entity, with the identifier of its type
+typedef std::pair<Component::tTypeID, Component*> tTypedComponent;
+
+/// Used to sort the components of an entity by type (see Scene::classifyEntities())
+static bool compareTypes(const tTypedComponent& a, const tTypedComponent& b)
+{
+    return (a.first < b.first);
+}
+
+//-----------------------------------------------------------------------
+
+/// Write the world matrices of a list of entities in a buffer (see
+/// Scene::exportWorldMatrices())
+static unsigned int writeWorldMatrices(TransformsStore* pStore,
+                                       Entity::tEntitiesList::const_iterator iter,
+                                       Entity::tEntitiesList::const_iterator iterEnd,
+                                       float* pBuffer, unsigned int uiSinceFrame,
+                                       unsigned int* pIndices)
+{
+    // Assertions
+    assert(pStore);
+    assert(pBuffer);
+
+    // Declarations
+    unsigned int nbMatrices = 0;
+    unsigned int index = 0;
+
+    pStore->update();
+
+    for (; iter != iterEnd; ++iter, ++index)
+    {
+        TransformsStore::tIndex slot = (*iter)->getTransforms()->getStoreIndex();
+
+        assert((*iter)->getTransforms()->getStore() == pStore);
+
+        if ((uiSinceFrame != 0) && (pStore->getLastChangeFrame(slot) < uiSinceFrame))
+            continue;
+
+        const Matrix4& matrix = pStore->getWorldMatrix(slot);
+
+        for (unsigned int row = 0; row < 4; ++row)
+        {
+            for (unsigned int col = 0; col < 4; ++col)
+                *pBuffer++ = (float) matrix[row][col];
+        }
+
+        if (pIndices)
+            pIndices[nbMatrices] = index;
+
+        ++nbMatrices;
+    }
+
+    return nbMatrices;
+}
+
+
 /***************************** CONSTRUCTION / DESTRUCTION *******************************/
 
 Scene::Scene(const std::string& strName)
-: m_strName(strName), m_bEnabled(true), m_bShown(false)
+: m_strName(strName), m_bEnabled(true), m_bShown(false), m_bArchetypesEnabled(false),
+  m_pSpatialIndex(0), m_pBoundsHierarchy(0)
 {
     // Assertions
     assert(ScenesManager::getSingletonPtr());
@@ -52,6 +134,14 @@ Scene::~Scene()
         enable(false);
 
     destroyAll();
+    destroyArchetypes();
+    enableSpatialIndex(false);
+
+    while (!m_freeEntities.empty())
+    {
+        delete m_freeEntities.back();
+        m_freeEntities.pop_back();
+    }
 
     ScenesManager::getSingletonPtr()->_destroyScene(this);
 }
@@ -126,9 +216,21 @@ Entity* Scene::create(const std::string& strName, Entity* pParent)
     if (pParent && (pParent->getScene() != this))
         return 0;
 
-    Entity* pEntity = new Entity(strName, this, pParent);
+    Entity* pEntity = 0;
 
-    m_entities.push_back(pEntity);
+    // Reuse a recycled entity if possible
+    if (!m_freeEntities.empty())
+    {
+        pEntity = m_freeEntities.back();
+        m_freeEntities.pop_back();
+        pEntity->reuse(strName, pParent);
+    }
+    else
+    {
+        pEntity = new Entity(strName, this, pParent);
+    }
+
+    addEntity(pEntity);
 
     return pEntity;
 }
@@ -139,18 +241,9 @@ Entity* Scene::getEntity(const std::string& strName)
 {
     assert(!strName.empty() && "The name is empty");
 
-    // Declarations
-    Entity::tEntitiesNativeIterator iter, iterEnd;
-
-    // Search the entity
-    for (iter = m_entities.begin(), iterEnd = m_entities.end(); iter != iterEnd; ++iter)
-    {
-        if ((*iter)->getName() == strName)
-        {
-            // Return it
-            return (*iter);
-        }
-    }
+    tEntitiesByName::iterator iter = m_entitiesByName.find(strName);
+    if (iter != m_entitiesByName.end())
+        return iter->second;
 
     // Not found
     return 0;
@@ -163,19 +256,9 @@ void Scene::destroy(const std::string& strName)
     // Assertions
     assert(!strName.empty() && "The name is empty");
 
-    // Declarations
-    Entity::tEntitiesNativeIterator iter, iterEnd;
-
-    // Search the entity
-    for (iter = m_entities.begin(), iterEnd = m_entities.end(); iter != iterEnd; ++iter)
-    {
-        if ((*iter)->getName() == strName)
-        {
-            delete (*iter);
-            m_entities.erase(iter);
-            return;
-        }
-    }
+    Entity* pEntity = getEntity(strName);
+    if (pEntity)
+        recycle(pEntity);
 }
 
 //-----------------------------------------------------------------------
@@ -185,57 +268,144 @@ void Scene::destroy(Entity* pEntity)
     // Assertions
     assert(pEntity && "Invalid entity");
 
-    // Declarations
-    Entity::tEntitiesNativeIterator iter, iterEnd;
+    if (getEntity(pEntity->getHandle()) == pEntity)
+        recycle(pEntity);
+}
 
-    // Search the entity
-    for (iter = m_entities.begin(), iterEnd = m_entities.end(); iter != iterEnd; ++iter)
+//-----------------------------------------------------------------------
+
+void Scene::destroyAll()
+{
+    // Destroy all the entities at once
+    Entity::tEntitiesList entities(m_entities);
+    recycle(entities);
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::reserveEntities(unsigned int nbEntities)
+{
+    if (m_entities.capacity() < m_entities.size() + nbEntities)
+        m_entities.reserve(m_entities.size() + nbEntities);
+
+    m_entitiesByName.reserve(m_entities.size() + nbEntities);
+    m_freeEntities.reserve(nbEntities);
+
+    // Each entity uses a handle, and its transforms a handle and a slot in the store
+    m_entitiesHandles.reserve(m_entitiesHandles.getNbObjects() + nbEntities);
+    m_componentsHandles.reserve(m_componentsHandles.getNbObjects() + nbEntities);
+    m_newComponents.reserve(m_newComponents.size() + nbEntities);
+    m_transformsStore.reserve(m_transformsStore.getNbTransforms() + nbEntities);
+
+    while (m_freeEntities.size() < nbEntities)
+        m_freeEntities.push_back(new Entity(this));
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::recycle(Entity* pEntity)
+{
+    // Assertions
+    assert(pEntity);
+
+    // Retrieve all the children of the entity
+    Entity::tEntitiesList entities;
+    entities.push_back(pEntity);
+
+    for (unsigned int i = 0; i < entities.size(); ++i)
     {
-        if (*iter == pEntity)
-        {
-            delete pEntity;
-            m_entities.erase(iter);
-            return;
-        }
+        Entity* pParent = entities[i];
+        entities.insert(entities.end(), pParent->m_children.begin(), pParent->m_children.end());
     }
+
+    recycle(entities);
 }
 
 //-----------------------------------------------------------------------
 
-void Scene::destroyAll()
+void Scene::recycle(const Entity::tEntitiesList& entities)
 {
-    // Destroy all the entities
-    while (!m_entities.empty())
+    // Remove the entities from the list first, and mark them so the links between their
+    // components are just released
+    for (unsigned int i = 0; i < entities.size(); ++i)
+    {
+        entities[i]->m_bBeingDestroyed = true;
+        removeEntity(entities[i]);
+    }
+
+    for (unsigned int i = 0; i < entities.size(); ++i)
+        entities[i]->recycle();
+
+    m_freeEntities.reserve(m_freeEntities.size() + entities.size());
+
+    for (unsigned int i = 0; i < entities.size(); ++i)
     {
-        delete m_entities.front();
-        m_entities.erase(m_entities.begin());
+        entities[i]->m_bBeingDestroyed = false;
+        m_freeEntities.push_back(entities[i]);
     }
 }
 
 //-----------------------------------------------------------------------
 
-void Scene::transfer(const std::string& strName, Scene* pSrcScene)
+void Scene::addEntity(Entity* pEntity)
 {
     // Assertions
-    assert(!strName.empty() && "The name is empty");
-    assert(pSrcScene);
+    assert(pEntity);
+    assert((m_entitiesByName.find(pEntity->getName()) == m_entitiesByName.end()) &&
+           "Entity name already used");
 
-    // Declarations
-    Entity::tEntitiesNativeIterator iter, iterEnd;
+    pEntity->m_uiIndex = (unsigned int) m_entities.size();
+    m_entities.push_back(pEntity);
+    m_entitiesByName[pEntity->getName()] = pEntity;
+    pEntity->m_handle = m_entitiesHandles.allocate(pEntity);
+}
+
+//-----------------------------------------------------------------------
 
-    // Search the entity
-    for (iter = pSrcScene->m_entities.begin(), iterEnd = pSrcScene->m_entities.end();
-         iter != iterEnd; ++iter)
+void Scene::removeEntity(Entity* pEntity)
+{
+    // Assertions
+    assert(pEntity);
+    assert(pEntity->m_uiIndex < m_entities.size());
+    assert(m_entities[pEntity->m_uiIndex] == pEntity);
+
+    // Move the last entity in the hole. Its world transforms are marked as changed, so
+    // exportWorldMatrices() reports its matrix at its new index.
+    Entity* pLastEntity = m_entities.back();
+    if (pLastEntity != pEntity)
     {
-        if ((*iter)->getName() == strName)
-        {
-            Entity* pEntity = *iter;
-            pSrcScene->m_entities.erase(iter);
-            pEntity->m_pScene = this;
-            m_entities.push_back(pEntity);
-            return;
-        }
+        m_entities[pEntity->m_uiIndex] = pLastEntity;
+        pLastEntity->m_uiIndex = pEntity->m_uiIndex;
+
+        Transforms* pTransforms = pLastEntity->getTransforms();
+        pTransforms->getStore()->_markChanged(pTransforms->getStoreIndex());
     }
+
+    m_entities.pop_back();
+
+    m_entitiesByName.erase(pEntity->getName());
+
+    if (m_pSpatialIndex)
+    {
+        m_pSpatialIndex->_remove(pEntity);
+        m_pBoundsHierarchy->_remove(pEntity);
+    }
+
+    m_entitiesHandles.release(pEntity->m_handle);
+    pEntity->m_handle = tHandle();
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::transfer(const std::string& strName, Scene* pSrcScene)
+{
+    // Assertions
+    assert(!strName.empty() && "The name is empty");
+    assert(pSrcScene);
+
+    Entity* pEntity = pSrcScene->getEntity(strName);
+    if (pEntity)
+        transfer(pEntity);
 }
 
 //-----------------------------------------------------------------------
@@ -247,19 +417,429 @@ void Scene::transfer(Entity* pEntity)
     assert(pEntity->getScene());
     assert(pEntity->getScene() != this);
 
+    Scene* pSrcScene = pEntity->getScene();
+    if (pSrcScene->getEntity(pEntity->getHandle()) != pEntity)
+        return;
+
+    // The source scene must forget the entity
+    if (pEntity->m_bUnclassified)
+    {
+        Entity::tEntitiesList& entities = pSrcScene->m_unclassifiedEntities;
+        entities.erase(std::remove(entities.begin(), entities.end(), pEntity), entities.end());
+        pEntity->m_bUnclassified = false;
+    }
+
+    pSrcScene->removeEntity(pEntity);
+    pEntity->m_pScene = this;
+    addEntity(pEntity);
+    moveComponents(pEntity, pSrcScene, this);
+}
+
+
+/********************************** COMPONENTS BY TYPE **********************************/
+
+Component::tComponentsIterator Scene::getComponentsIterator(const std::string& strType)
+{
+    Component::tComponentsList& components = getComponentsOfType(strType);
+    return Component::tComponentsIterator(components.begin(), components.end());
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Scene::getNbComponents(const std::string& strType)
+{
+    return (unsigned int) getComponentsOfType(strType).size();
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::_registerComponent(Component* pComponent)
+{
+    // Assertions
+    assert(pComponent);
+
+    pComponent->m_handle = m_componentsHandles.allocate(pComponent);
+
+    // The entity of the component doesn't belong to its archetype anymore
+    if (m_bArchetypesEnabled && pComponent->getList()->getEntity())
+        declassify(pComponent->getList()->getEntity());
+
+    // The components are registered by their constructor, when their actual type isn't
+    // known yet: they are sorted later
+    pComponent->m_pSceneList = &m_newComponents;
+    pComponent->m_uiSceneIndex = (unsigned int) m_newComponents.size();
+    m_newComponents.push_back(pComponent);
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::_unregisterComponent(Component* pComponent)
+{
+    // Assertions
+    assert(pComponent);
+
+    // Not registered (for instance, the transforms of a recycled entity)
+    if (m_componentsHandles.get(pComponent->m_handle) != pComponent)
+        return;
+
+    m_componentsHandles.release(pComponent->m_handle);
+    pComponent->m_handle = tHandle();
+
+    // The entity of the component doesn't belong to its archetype anymore
+    if (m_bArchetypesEnabled && pComponent->getList()->getEntity())
+        declassify(pComponent->getList()->getEntity());
+
+    // Move the last component of the list in the hole
+    Component::tComponentsList& components = *pComponent->m_pSceneList;
+
+    assert(components[pComponent->m_uiSceneIndex] == pComponent);
+
+    Component* pLastComponent = components.back();
+    components[pComponent->m_uiSceneIndex] = pLastComponent;
+    pLastComponent->m_uiSceneIndex = pComponent->m_uiSceneIndex;
+    components.pop_back();
+
+    pComponent->m_pSceneList = 0;
+    pComponent->m_uiSceneIndex = 0;
+}
+
+//-----------------------------------------------------------------------
+
+Component::tComponentsList& Scene::getComponentsOfType(const std::string& strType)
+{
+    // Sort the new components
+    for (unsigned int i = 0; i < m_newComponents.size(); ++i)
+    {
+        Component* pComponent = m_newComponents[i];
+        Component::tComponentsList& components = m_componentsByType[pComponent->getType()];
+
+        pComponent->m_pSceneList = &components;
+        pComponent->m_uiSceneIndex = (unsigned int) components.size();
+        components.push_back(pComponent);
+    }
+
+    m_newComponents.clear();
+
+    return m_componentsByType[strType];
+}
+
+
+/************************************** ARCHETYPES **************************************/
+
+void Scene::enableArchetypes(bool bEnabled)
+{
+    if (bEnabled == m_bArchetypesEnabled)
+        return;
+
+    m_bArchetypesEnabled = bEnabled;
+
+    if (m_bArchetypesEnabled)
+    {
+        m_unclassifiedEntities = m_entities;
+
+        for (unsigned int i = 0; i < m_entities.size(); ++i)
+            m_entities[i]->m_bUnclassified = true;
+    }
+    else
+    {
+        destroyArchetypes();
+    }
+}
+
+//-----------------------------------------------------------------------
+
+Scene::tArchetypesIterator Scene::getArchetypesIterator()
+{
+    classifyEntities();
+    return tArchetypesIterator(m_archetypes.begin(), m_archetypes.end());
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Scene::getNbArchetypes()
+{
+    classifyEntities();
+    return (unsigned int) m_archetypes.size();
+}
+
+//-----------------------------------------------------------------------
+
+Archetype* Scene::getArchetype(Entity* pEntity)
+{
+    // Assertions
+    assert(pEntity);
+    assert(pEntity->getScene() == this);
+
+    classifyEntities();
+    return pEntity->m_pArchetype;
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::declassify(Entity* pEntity)
+{
+    // Assertions
+    assert(pEntity);
+
+    if (pEntity->m_pArchetype)
+    {
+        Entity* pMovedEntity = pEntity->m_pArchetype->_removeEntity(pEntity->m_uiArchetypeIndex);
+        if (pMovedEntity)
+            pMovedEntity->m_uiArchetypeIndex = pEntity->m_uiArchetypeIndex;
+
+        pEntity->m_pArchetype = 0;
+    }
+
+    // The types of the new components aren't known yet (they are still in construction),
+    // the entity is put in its new archetype later (unless it is being transferred to
+    // another scene, or already waiting)
+    if ((pEntity->getScene() == this) && !pEntity->m_bUnclassified)
+    {
+        m_unclassifiedEntities.push_back(pEntity);
+        pEntity->m_bUnclassified = true;
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::classifyEntities()
+{
     // Declarations
-    Entity::tEntitiesNativeIterator iter, iterEnd;
+    vector<tTypedComponent> components;
+    Archetype::tSignature   signature;
+    Component::tComponentsList sortedComponents;
 
-    // Search the entity
-    for (iter = pEntity->getScene()->m_entities.begin(), iterEnd = pEntity->getScene()->m_entities.end();
-         iter != iterEnd; ++iter)
+    for (unsigned int i = 0; i < m_unclassifiedEntities.size(); ++i)
     {
-        if (*iter == pEntity)
+        Entity* pEntity = m_unclassifiedEntities[i];
+        pEntity->m_bUnclassified = false;
+
+        // Skip the entities already processed, or destroyed since
+        if (pEntity->m_pArchetype || (getEntity(pEntity->getHandle()) != pEntity))
+            continue;
+
+        // Sort the components of the entity by type
+        components.clear();
+
+        Component::tComponentsIterator iter = pEntity->getComponentsIterator();
+        while (iter.hasMoreElements())
+        {
+            Component* pComponent = iter.getNext();
+            components.push_back(tTypedComponent(pComponent->getTypeID(), pComponent));
+        }
+
+        std::stable_sort(components.begin(), components.end(), compareTypes);
+
+        signature.clear();
+        sortedComponents.clear();
+        for (unsigned int j = 0; j < components.size(); ++j)
+        {
+            signature.push_back(components[j].first);
+            sortedComponents.push_back(components[j].second);
+        }
+
+        // Retrieve the archetype
+        Archetype* pArchetype = 0;
+
+        tArchetypesBySignature::iterator iterArchetype = m_archetypesBySignature.find(signature);
+        if (iterArchetype != m_archetypesBySignature.end())
+        {
+            pArchetype = iterArchetype->second;
+        }
+        else
         {
-            pEntity->getScene()->m_entities.erase(iter);
-            pEntity->m_pScene = this;
-            m_entities.push_back(pEntity);
-            return;
+            pArchetype = new Archetype(signature);
+            m_archetypes.push_back(pArchetype);
+            m_archetypesBySignature[signature] = pArchetype;
         }
+
+        pEntity->m_pArchetype = pArchetype;
+        pEntity->m_uiArchetypeIndex = pArchetype->_addEntity(pEntity, &sortedComponents[0]);
     }
+
+    m_unclassifiedEntities.clear();
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::destroyArchetypes()
+{
+    Entity::tEntitiesIterator iter(m_entities.begin(), m_entities.end());
+    while (iter.hasMoreElements())
+        iter.getNext()->m_pArchetype = 0;
+
+    for (unsigned int i = 0; i < m_archetypes.size(); ++i)
+        delete m_archetypes[i];
+
+    for (unsigned int i = 0; i < m_unclassifiedEntities.size(); ++i)
+        m_unclassifiedEntities[i]->m_bUnclassified = false;
+
+    m_archetypes.clear();
+    m_archetypesBySignature.clear();
+    m_unclassifiedEntities.clear();
+}
+
+
+/************************************ SPATIAL INDEX *************************************/
+
+void Scene::enableSpatialIndex(bool bEnabled, Real cellSize)
+{
+    if (bEnabled && m_pSpatialIndex && (m_pSpatialIndex->getCellSize() == cellSize))
+        return;
+
+    delete m_pSpatialIndex;
+    delete m_pBoundsHierarchy;
+    m_pSpatialIndex = 0;
+    m_pBoundsHierarchy = 0;
+
+    // Restart the tracking of the changes, so all the entities are indexed
+    m_transformsStore.setChangesTracked(false);
+
+    if (bEnabled)
+    {
+        m_pSpatialIndex = new SpatialIndex(cellSize);
+        m_pBoundsHierarchy = new BoundsHierarchy();
+        m_transformsStore.setChangesTracked(true);
+    }
+}
+
+//-----------------------------------------------------------------------
+
+SpatialIndex* Scene::getSpatialIndex()
+{
+    if (!m_pSpatialIndex)
+        return 0;
+
+    refreshSpatialIndex();
+
+    return m_pSpatialIndex;
+}
+
+//-----------------------------------------------------------------------
+
+BoundsHierarchy* Scene::getBoundsHierarchy()
+{
+    if (!m_pBoundsHierarchy)
+        return 0;
+
+    refreshSpatialIndex();
+
+    return m_pBoundsHierarchy;
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::refreshSpatialIndex()
+{
+    m_transformsStore._takeChanges(m_changedSlots);
+
+    for (unsigned int i = 0; i < m_changedSlots.size(); ++i)
+    {
+        TransformsStore::tIndex index = m_changedSlots[i];
+
+        // The slot might have been released since
+        if (!m_transformsStore.isUsed(index))
+            continue;
+
+        // Only the transforms of the entities of the scene are indexed
+        Transforms* pTransforms = m_transformsStore.getTransforms(index);
+        Entity* pEntity = pTransforms->getList()->getEntity();
+
+        if (!pEntity || (pEntity->getTransforms() != pTransforms) ||
+            (getEntity(pEntity->getHandle()) != pEntity))
+        {
+            continue;
+        }
+
+        m_pSpatialIndex->_update(pEntity, pTransforms->getWorldPosition());
+
+        if (pEntity->hasBounds())
+        {
+            m_pBoundsHierarchy->_update(pEntity,
+                                        pEntity->getBounds().transformed(pTransforms->getWorldMatrix()));
+        }
+        else
+        {
+            m_pBoundsHierarchy->_remove(pEntity);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::getEntitiesInRadius(const Vector3& center, Real radius,
+                                Entity::tEntitiesList& entities)
+{
+    assert(m_pSpatialIndex && "The spatial index isn't enabled");
+
+    getSpatialIndex()->getEntitiesInRadius(center, radius, entities);
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::getEntitiesInBox(const Vector3& min, const Vector3& max,
+                             Entity::tEntitiesList& entities)
+{
+    assert(m_pSpatialIndex && "The spatial index isn't enabled");
+
+    getSpatialIndex()->getEntitiesInBox(min, max, entities);
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::getNearestEntities(const Vector3& point, unsigned int nbEntities,
+                               Entity::tEntitiesList& entities)
+{
+    assert(m_pSpatialIndex && "The spatial index isn't enabled");
+
+    getSpatialIndex()->getNearestEntities(point, nbEntities, entities);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Scene::castRay(const Vector3& origin, const Vector3& direction,
+                            Real maxDistance, BoundsHierarchy::tRayHit* pHits,
+                            unsigned int maxHits)
+{
+    assert(m_pBoundsHierarchy && "The spatial index isn't enabled");
+
+    return getBoundsHierarchy()->castRay(origin, direction, maxDistance, pHits, maxHits);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Scene::getEntitiesInFrustum(const tFrustum& frustum, Entity** pEntities,
+                                         unsigned int maxEntities)
+{
+    assert(m_pBoundsHierarchy && "The spatial index isn't enabled");
+
+    return getBoundsHierarchy()->getEntitiesInFrustum(frustum, pEntities, maxEntities);
+}
+
+
+/****************************** MANAGEMENT OF THE TRANSFORMS ****************************/
+
+unsigned int Scene::exportWorldMatrices(float* pBuffer, unsigned int uiSinceFrame,
+                                        unsigned int* pIndices)
+{
+    return writeWorldMatrices(&m_transformsStore, m_entities.begin(), m_entities.end(),
+                              pBuffer, uiSinceFrame, pIndices);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int Scene::exportWorldMatrices(const Entity::tEntitiesList& entities, float* pBuffer,
+                                        unsigned int uiSinceFrame, unsigned int* pIndices)
+{
+    return writeWorldMatrices(&m_transformsStore, entities.begin(), entities.end(),
+                              pBuffer, uiSinceFrame, pIndices);
+}
+
+//-----------------------------------------------------------------------
+
+void Scene::rebaseOrigin(const Vector3& offset)
+{
+    m_transformsStore.rebaseOrigin(offset);
+
+    m_signals.fire(SIGNAL_SCENE_ORIGIN_CHANGED, new Variant(offset));
 }
@@ -8,6 +8,7 @@
 #include <Athena-Entities/Component.h>
 #include <Athena-Entities/ComponentsManager.h>
 #include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Prefab.h>
 #include <Athena-Entities/Scene.h>
 #include <Athena-Core/Data/Serialization.h>
 #include <Athena-Core/Data/DataStream.h>
@@ -147,7 +148,7 @@ Athena::Entities::Component* Athena::Entities::fromJSON(
 
     if (!pComponent)
     {
-        ATHENA_LOG_COMMENT("Attempt to create a component with name: " + id.strName);
+        ATHENA_LOG_COMMENT("Attempt to create a component with name: " + id.strName.str());
 
         while (!pComponent && (iter != iterEnd))
         {
@@ -386,6 +387,43 @@ Athena::Entities::Entity* Athena::Entities::fromJSON(const std::string& json_ent
 
 //-----------------------------------------------------------------------
 
+bool Athena::Entities::fromJSON(const rapidjson::Value& json_entity, Entities::Prefab* pPrefab)
+{
+    // Assertions
+    assert(pPrefab);
+
+    // Create the entities in a temporary scene
+    Scene scene("__prefab__");
+
+    Entity* pEntity = fromJSON(json_entity, &scene);
+    if (!pEntity)
+        return false;
+
+    pPrefab->compile(pEntity);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+
+bool Athena::Entities::fromJSON(const std::string& json_entity, Entities::Prefab* pPrefab)
+{
+    // Assertions
+    assert(pPrefab);
+
+    // Convert to a JSON representation
+    Document document;
+    if (document.Parse<0>(json_entity.c_str()).HasParseError())
+    {
+        ATHENA_LOG_ERROR(document.GetParseError());
+        return false;
+    }
+
+    return fromJSON(document, pPrefab);
+}
+
+//-----------------------------------------------------------------------
+
 void Athena::Entities::toJSON(Entities::Scene* pScene,
                               rapidjson::Value &json_scene,
                               rapidjson::Value::AllocatorType &allocator)
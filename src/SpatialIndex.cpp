@@ -0,0 +1,308 @@
+/** @file   SpatialIndex.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::SpatialIndex'
+*/
+
+#include <Athena-Entities/SpatialIndex.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace std;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+SpatialIndex::SpatialIndex(Real cellSize)
+: m_cellSize(cellSize), m_nbEntities(0)
+{
+    assert(cellSize > 0.0f);
+}
+
+//-----------------------------------------------------------------------
+
+SpatialIndex::~SpatialIndex()
+{
+}
+
+
+/*************************************** QUERIES ****************************************/
+
+void SpatialIndex::getEntitiesInRadius(const Vector3& center, Real radius,
+                                       Entity::tEntitiesList& entities) const
+{
+    // Declarations
+    tCellsList cells;
+    Real squaredRadius = radius * radius;
+
+    getCells(getCell(center - Vector3(radius)), getCell(center + Vector3(radius)), cells);
+
+    for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+        const std::vector<unsigned int>& cell = *cells[i];
+
+        for (unsigned int j = 0; j < cell.size(); ++j)
+        {
+            const tEntry& entry = m_entries[cell[j]];
+            if (entry.position.squaredDistance(center) <= squaredRadius)
+                entities.push_back(entry.pEntity);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void SpatialIndex::getEntitiesInBox(const Vector3& min, const Vector3& max,
+                                    Entity::tEntitiesList& entities) const
+{
+    // Declarations
+    tCellsList cells;
+
+    getCells(getCell(min), getCell(max), cells);
+
+    for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+        const std::vector<unsigned int>& cell = *cells[i];
+
+        for (unsigned int j = 0; j < cell.size(); ++j)
+        {
+            const tEntry& entry = m_entries[cell[j]];
+
+            if ((entry.position.x >= min.x) && (entry.position.x <= max.x) &&
+                (entry.position.y >= min.y) && (entry.position.y <= max.y) &&
+                (entry.position.z >= min.z) && (entry.position.z <= max.z))
+            {
+                entities.push_back(entry.pEntity);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void SpatialIndex::getNearestEntities(const Vector3& point, unsigned int nbEntities,
+                                      Entity::tEntitiesList& entities) const
+{
+    if ((nbEntities == 0) || (m_nbEntities == 0))
+        return;
+
+    // Declarations
+    std::vector<std::pair<Real, unsigned int> > candidates;
+    unsigned int nbVisited = 0;
+    tCell center = getCell(point);
+
+    // Visit the cells by growing rings (cubic shells) around the cell of the point
+    for (int ring = 0; nbVisited < m_nbEntities; ++ring)
+    {
+        // Once the rings cover too many cells compared to the non-empty ones, it is cheaper
+        // to go through the remaining cells directly (a lookup in the hash map costs about
+        // as much as iterating over several cells)
+        double side = 2.0 * ring + 1.0;
+        if ((ring > 0) && (side * side * side > (double) m_cells.size() / 8.0))
+        {
+            for (tCellsMap::const_iterator iter = m_cells.begin(); iter != m_cells.end(); ++iter)
+            {
+                int distance = max(abs(iter->first.x - center.x),
+                                   max(abs(iter->first.y - center.y), abs(iter->first.z - center.z)));
+                if (distance < ring)
+                    continue;
+
+                for (unsigned int i = 0; i < iter->second.size(); ++i)
+                {
+                    const tEntry& entry = m_entries[iter->second[i]];
+                    candidates.push_back(make_pair(entry.position.squaredDistance(point), iter->second[i]));
+                }
+            }
+
+            break;
+        }
+
+        for (int x = -ring; x <= ring; ++x)
+        {
+            for (int y = -ring; y <= ring; ++y)
+            {
+                // Only the cells on the shell
+                bool bOnShell = (abs(x) == ring) || (abs(y) == ring);
+                int step = (bOnShell ? 1 : max(2 * ring, 1));
+
+                for (int z = -ring; z <= ring; z += step)
+                {
+                    tCell cell = { center.x + x, center.y + y, center.z + z };
+
+                    tCellsMap::const_iterator iter = m_cells.find(cell);
+                    if (iter == m_cells.end())
+                        continue;
+
+                    for (unsigned int i = 0; i < iter->second.size(); ++i)
+                    {
+                        const tEntry& entry = m_entries[iter->second[i]];
+                        candidates.push_back(make_pair(entry.position.squaredDistance(point), iter->second[i]));
+                    }
+
+                    nbVisited += (unsigned int) iter->second.size();
+                }
+            }
+        }
+
+        // The entities of the next rings are at least at 'ring * m_cellSize' of the point
+        if (candidates.size() >= nbEntities)
+        {
+            nth_element(candidates.begin(), candidates.begin() + (nbEntities - 1), candidates.end());
+
+            Real limit = ring * m_cellSize;
+            if (candidates[nbEntities - 1].first <= limit * limit)
+                break;
+        }
+    }
+
+    // Keep the nearest entities
+    unsigned int nb = min(nbEntities, (unsigned int) candidates.size());
+    partial_sort(candidates.begin(), candidates.begin() + nb, candidates.end());
+
+    for (unsigned int i = 0; i < nb; ++i)
+        entities.push_back(m_entries[candidates[i].second].pEntity);
+}
+
+
+/*************************************** METHODS ****************************************/
+
+bool SpatialIndex::contains(Entity* pEntity) const
+{
+    // Assertions
+    assert(pEntity);
+
+    unsigned int entry = pEntity->getHandle().uiIndex;
+    return (entry < m_entries.size()) && (m_entries[entry].pEntity == pEntity);
+}
+
+//-----------------------------------------------------------------------
+
+void SpatialIndex::_update(Entity* pEntity, const Vector3& position)
+{
+    // Assertions
+    assert(pEntity);
+    assert(pEntity->getHandle().isValid());
+
+    unsigned int index = pEntity->getHandle().uiIndex;
+
+    if (index >= m_entries.size())
+    {
+        tEntry empty = { 0, Vector3::ZERO, { 0, 0, 0 }, 0 };
+        m_entries.resize(index + 1, empty);
+    }
+
+    tEntry& entry = m_entries[index];
+    tCell cell = getCell(position);
+
+    // Already in the right cell
+    if (entry.pEntity == pEntity)
+    {
+        entry.position = position;
+        if (entry.cell == cell)
+            return;
+
+        removeFromCell(index);
+    }
+    else
+    {
+        // The slot might still be used by an entity destroyed since
+        if (entry.pEntity)
+            removeFromCell(index);
+        else
+            ++m_nbEntities;
+
+        entry.pEntity = pEntity;
+        entry.position = position;
+    }
+
+    std::vector<unsigned int>& entries = m_cells[cell];
+
+    entry.cell = cell;
+    entry.uiIndexInCell = (unsigned int) entries.size();
+    entries.push_back(index);
+}
+
+//-----------------------------------------------------------------------
+
+void SpatialIndex::_remove(Entity* pEntity)
+{
+    if (!contains(pEntity))
+        return;
+
+    unsigned int index = pEntity->getHandle().uiIndex;
+
+    removeFromCell(index);
+    m_entries[index].pEntity = 0;
+    --m_nbEntities;
+}
+
+//-----------------------------------------------------------------------
+
+SpatialIndex::tCell SpatialIndex::getCell(const Vector3& position) const
+{
+    tCell cell = { (int) std::floor(position.x / m_cellSize),
+                   (int) std::floor(position.y / m_cellSize),
+                   (int) std::floor(position.z / m_cellSize) };
+    return cell;
+}
+
+//-----------------------------------------------------------------------
+
+void SpatialIndex::getCells(const tCell& min, const tCell& max, tCellsList& cells) const
+{
+    double nbCells = ((double) max.x - min.x + 1.0) * ((double) max.y - min.y + 1.0) *
+                     ((double) max.z - min.z + 1.0);
+
+    // Cheaper to go through the non-empty cells directly
+    if (nbCells > (double) m_cells.size())
+    {
+        for (tCellsMap::const_iterator iter = m_cells.begin(); iter != m_cells.end(); ++iter)
+        {
+            const tCell& cell = iter->first;
+
+            if ((cell.x >= min.x) && (cell.x <= max.x) && (cell.y >= min.y) &&
+                (cell.y <= max.y) && (cell.z >= min.z) && (cell.z <= max.z))
+            {
+                cells.push_back(&iter->second);
+            }
+        }
+
+        return;
+    }
+
+    tCell cell;
+    for (cell.x = min.x; cell.x <= max.x; ++cell.x)
+    {
+        for (cell.y = min.y; cell.y <= max.y; ++cell.y)
+        {
+            for (cell.z = min.z; cell.z <= max.z; ++cell.z)
+            {
+                tCellsMap::const_iterator iter = m_cells.find(cell);
+                if (iter != m_cells.end())
+                    cells.push_back(&iter->second);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void SpatialIndex::removeFromCell(unsigned int entry)
+{
+    tCellsMap::iterator iter = m_cells.find(m_entries[entry].cell);
+    assert(iter != m_cells.end());
+
+    // Move the last entry of the cell in the hole
+    std::vector<unsigned int>& entries = iter->second;
+    unsigned int index = m_entries[entry].uiIndexInCell;
+
+    entries[index] = entries.back();
+    m_entries[entries[index]].uiIndexInCell = index;
+    entries.pop_back();
+
+    if (entries.empty())
+        m_cells.erase(iter);
+}
@@ -8,6 +8,8 @@
 */
 
 #include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/TransformsStore.h>
+#include <Athena-Entities/Scene.h>
 #include <Athena-Entities/Signals.h>
 #include <Athena-Core/Signals/SignalsList.h>
 #include <Athena-Core/Utils/PropertiesList.h>
@@ -25,16 +27,25 @@ using namespace std;
 ///< Name of the type of component
 const std::string Transforms::TYPE = "Athena/Transforms";
 
+///< Identifier of the type of component
+const Component::tTypeID Transforms::TYPE_ID = Component::_newTypeID(&Component::TYPE_ID);
+
 
 /***************************** CONSTRUCTION / DESTRUCTION *******************************/
 
 Transforms::Transforms(const std::string& strName, ComponentsList* pList)
-: Component(strName, pList), m_position(Vector3::ZERO), m_orientation(Quaternion::IDENTITY),
-  m_scale(Vector3::UNIT_SCALE), m_fullPosition(Vector3::ZERO), m_fullOrientation(Quaternion::IDENTITY),
-  m_fullScale(Vector3::UNIT_SCALE), m_bDirty(true), m_uiNbFullCalculationRequests(0),
-  m_bInheritOrientation(true), m_bInheritScale(true)
+: Component(strName, pList), m_pStore(0), m_uiIndex(TransformsStore::INVALID_INDEX)
 {
     m_id.type = COMP_TRANSFORMS;
+    m_typeID = TYPE_ID;
+
+    // Allocate a slot in the store of the scene (if any)
+    Scene* pScene = pList->getScene();
+    if (!pScene && pList->getEntity())
+        pScene = pList->getEntity()->getScene();
+
+    m_pStore = (pScene ? pScene->getTransformsStore() : TransformsStore::getDefault());
+    m_uiIndex = m_pStore->_allocate(this);
 
     setTransforms(0);
 }
@@ -43,6 +54,8 @@ Transforms::Transforms(const std::string& strName, ComponentsList* pList)
 
 Transforms::~Transforms()
 {
+    if (!_isParked())
+        m_pStore->_release(m_uiIndex);
 }
 
 //-----------------------------------------------------------------------
@@ -56,7 +69,7 @@ Transforms* Transforms::create(const std::string& strName, ComponentsList* pList
 
 Transforms* Transforms::cast(Component* pComponent)
 {
-    return dynamic_cast<Transforms*>(pComponent);
+    return component_cast<Transforms>(pComponent);
 }
 
 
@@ -64,7 +77,7 @@ Transforms* Transforms::cast(Component* pComponent)
 
 void Transforms::setPosition(const Vector3& pos)
 {
-    m_position = pos;
+    m_pStore->setPosition(m_uiIndex, pos);
     needUpdate();
 }
 
@@ -79,17 +92,17 @@ void Transforms::setPosition(Real x, Real y, Real z)
 
 void Transforms::translate(const Vector3& d, tTransformSpace relativeTo)
 {
-    Vector3 adjusted;
+    Vector3 position = getPosition();
 
     switch(relativeTo)
     {
     case TS_LOCAL:
         // Position is relative to parent so transform downwards
-        m_position += m_orientation * d;
+        position += getOrientation() * d;
         break;
 
     case TS_PARENT:
-        m_position += d;
+        position += d;
         break;
 
     case TS_WORLD:
@@ -97,13 +110,14 @@ void Transforms::translate(const Vector3& d, tTransformSpace relativeTo)
             // Position is relative to parent so transform upwards
             Transforms* pParent = getTransforms();
             if (pParent)
-                m_position += (pParent->getWorldOrientation().Inverse() * d) / pParent->getWorldScale();
+                position += (pParent->getWorldOrientation().Inverse() * d) / pParent->getWorldScale();
             else
-                m_position += d;
+                position += d;
             break;
         }
     }
 
+    m_pStore->setPosition(m_uiIndex, position);
     needUpdate();
 }
 
@@ -118,10 +132,10 @@ void Transforms::translate(Real x, Real y, Real z, tTransformSpace relativeTo)
 
 Vector3 Transforms::getWorldPosition()
 {
-    if (m_bDirty)
+    if (m_pStore->isDirty(m_uiIndex))
         update();
 
-    return m_fullPosition;
+    return m_pStore->getWorldPosition(m_uiIndex);
 }
 
 
@@ -148,7 +162,7 @@ void Transforms::setDirection(const Vector3& vec, tTransformSpace relativeTo,
         break;
 
     case TS_PARENT:
-        if (m_bInheritOrientation && pParentTransforms)
+        if (inheritOrientation() && pParentTransforms)
             targetDir = pParentTransforms->getWorldOrientation() * targetDir;
         break;
 
@@ -179,7 +193,7 @@ void Transforms::setDirection(const Vector3& vec, tTransformSpace relativeTo,
     }
 
     // Set target orientation, transformed to parent space
-    if (pParentTransforms && m_bInheritOrientation)
+    if (pParentTransforms && inheritOrientation())
         setOrientation(pParentTransforms->getWorldOrientation().UnitInverse() * targetOrientation);
     else
         setOrientation(targetOrientation);
@@ -199,7 +213,7 @@ void Transforms::lookAt(const Vector3& targetPoint, tTransformSpace relativeTo,
         break;
 
     case TS_PARENT:
-        origin = m_position;
+        origin = getPosition();
         break;
 
     case TS_LOCAL:
@@ -214,7 +228,7 @@ void Transforms::lookAt(const Vector3& targetPoint, tTransformSpace relativeTo,
 
 void Transforms::setOrientation(const Quaternion& q)
 {
-    m_orientation = q;
+    m_pStore->setOrientation(m_uiIndex, q);
     needUpdate();
 }
 
@@ -260,24 +274,27 @@ void Transforms::rotate(const Vector3& axis, const Radian& angle,
 
 void Transforms::rotate(const Quaternion& q, tTransformSpace relativeTo)
 {
+    Quaternion orientation = getOrientation();
+
     switch (relativeTo)
     {
     case TS_PARENT:
         // Rotations are normally relative to local axes, transform up
-        m_orientation = q * m_orientation;
+        orientation = q * orientation;
         break;
 
     case TS_WORLD:
         // Rotations are normally relative to local axes, transform up
-        m_orientation = m_orientation * getWorldOrientation().Inverse() * q * getWorldOrientation();
+        orientation = orientation * getWorldOrientation().Inverse() * q * getWorldOrientation();
         break;
 
     case TS_LOCAL:
         // Note the order of the mult, i.e. q comes after
-        m_orientation = m_orientation * q;
+        orientation = orientation * q;
         break;
     }
 
+    m_pStore->setOrientation(m_uiIndex, orientation);
     needUpdate();
 }
 
@@ -285,7 +302,7 @@ void Transforms::rotate(const Quaternion& q, tTransformSpace relativeTo)
 
 void Transforms::resetOrientation()
 {
-    m_orientation = Quaternion::IDENTITY;
+    m_pStore->setOrientation(m_uiIndex, Quaternion::IDENTITY);
     needUpdate();
 }
 
@@ -293,7 +310,7 @@ void Transforms::resetOrientation()
 
 void Transforms::setInheritOrientation(bool bInherit)
 {
-    m_bInheritOrientation = bInherit;
+    m_pStore->setInheritOrientation(m_uiIndex, bInherit);
     needUpdate();
 }
 
@@ -301,10 +318,10 @@ void Transforms::setInheritOrientation(bool bInherit)
 
 Quaternion Transforms::getWorldOrientation()
 {
-    if (m_bDirty)
+    if (m_pStore->isDirty(m_uiIndex))
         update();
 
-    return m_fullOrientation;
+    return m_pStore->getWorldOrientation(m_uiIndex);
 }
 
 
@@ -312,7 +329,7 @@ Quaternion Transforms::getWorldOrientation()
 
 void Transforms::setScale(const Vector3& scale)
 {
-    m_scale = scale;
+    m_pStore->setScale(m_uiIndex, scale);
     needUpdate();
 }
 
@@ -327,7 +344,7 @@ void Transforms::setScale(Real x, Real y, Real z)
 
 void Transforms::scale(const Vector3& scale)
 {
-    m_scale = m_scale * scale;
+    m_pStore->setScale(m_uiIndex, getScale() * scale);
     needUpdate();
 }
 
@@ -342,7 +359,7 @@ void Transforms::scale(Real x, Real y, Real z)
 
 void Transforms::setInheritScale(bool bInherit)
 {
-    m_bInheritScale = bInherit;
+    m_pStore->setInheritScale(m_uiIndex, bInherit);
     needUpdate();
 }
 
@@ -350,10 +367,83 @@ void Transforms::setInheritScale(bool bInherit)
 
 Vector3 Transforms::getWorldScale()
 {
-    if (m_bDirty)
+    if (m_pStore->isDirty(m_uiIndex))
+        update();
+
+    return m_pStore->getWorldScale(m_uiIndex);
+}
+
+
+/****************************** POSITION, ORIENTATION & SCALE ******************************/
+
+void Transforms::setTransform(const Vector3& position, const Quaternion& orientation,
+                              const Vector3& scale)
+{
+    m_pStore->setPosition(m_uiIndex, position);
+    m_pStore->setOrientation(m_uiIndex, orientation);
+    m_pStore->setScale(m_uiIndex, scale);
+    needUpdate();
+}
+
+
+/************************************* WORLD MATRIX *************************************/
+
+const Matrix4& Transforms::getWorldMatrix()
+{
+    if (m_pStore->isDirty(m_uiIndex))
+        update();
+
+    return m_pStore->getWorldMatrix(m_uiIndex);
+}
+
+//-----------------------------------------------------------------------
+
+const Matrix4& Transforms::getInverseWorldMatrix()
+{
+    if (m_pStore->isDirty(m_uiIndex))
+        update();
+
+    return m_pStore->getInverseWorldMatrix(m_uiIndex);
+}
+
+
+/************************************ INTERPOLATION *************************************/
+
+void Transforms::getInterpolatedWorldTransforms(Real alpha, Vector3& position,
+                                                Quaternion& orientation, Vector3& scale,
+                                                bool bSlerp)
+{
+    if (m_pStore->isDirty(m_uiIndex))
         update();
 
-    return m_fullScale;
+    m_pStore->getInterpolatedWorldTransforms(m_uiIndex, alpha, position, orientation,
+                                             scale, bSlerp);
+}
+
+
+/********************************** ABSOLUTE POSITION ***********************************/
+
+tAbsolutePosition Transforms::getAbsoluteWorldPosition()
+{
+    return m_pStore->getOrigin() + getWorldPosition();
+}
+
+//-----------------------------------------------------------------------
+
+void Transforms::setAbsoluteWorldPosition(const tAbsolutePosition& position)
+{
+    // Same as a translation in world space, but without subtracting the current world
+    // position (which could be far from the target one)
+    Vector3 newPosition = position - m_pStore->getOrigin();
+
+    Transforms* pParent = getTransforms();
+    if (pParent)
+    {
+        newPosition = (pParent->getWorldOrientation().Inverse() *
+                      (newPosition - pParent->getWorldPosition())) / pParent->getWorldScale();
+    }
+
+    setPosition(newPosition);
 }
 
 
@@ -361,62 +451,126 @@ Vector3 Transforms::getWorldScale()
 
 void Transforms::needUpdate()
 {
-    onTransformsChanged();
+    // During a batch, the notification is postponed until the end of it
+    if (m_pStore->isInBatch())
+        m_pStore->_deferUpdate(m_uiIndex);
+    else
+        onTransformsChanged();
 }
 
 //-----------------------------------------------------------------------
 
 void Transforms::update()
 {
-    if (!m_bDirty)
+    if (!m_pStore->isDirty(m_uiIndex))
         return;
 
     Transforms* pParent = getTransforms();
     if (pParent)
     {
-        // Update orientation
-        const Quaternion& parentOrientation = pParent->getWorldOrientation();
-        if (m_bInheritOrientation)
-        {
-            // Combine orientation with that of parent
-            m_fullOrientation = parentOrientation * m_orientation;
-            m_fullOrientation.normalise();
-        }
-        else
-        {
-            // No inheritence
-            m_fullOrientation = m_orientation;
-        }
+        // Combine our transforms with the ones of the parent
+        m_pStore->_computeWorldTransforms(m_uiIndex, pParent->getWorldPosition(),
+                                          pParent->getWorldOrientation(),
+                                          pParent->getWorldScale());
+    }
+    else
+    {
+        // No parent
+        m_pStore->_computeWorldTransforms(m_uiIndex);
+    }
+}
 
-        // Update scale
-        const Vector3& parentScale = pParent->getWorldScale();
-        if (m_bInheritScale)
-        {
-            // Scale own position by parent scale, NB just combine
-            // as equivalent axes, no shearing
-            m_fullScale = parentScale * m_scale;
-        }
-        else
-        {
-            // No inheritence
-            m_fullScale = m_scale;
-        }
+//-----------------------------------------------------------------------
+
+void Transforms::_setStore(TransformsStore* pStore)
+{
+    // Assertions
+    assert(pStore);
+
+    if (pStore == m_pStore)
+        return;
 
-        // Change position vector based on parent's orientation & scale
-        m_fullPosition = parentOrientation * (parentScale * m_position);
+    // Move our data into a slot of the new store
+    TransformsStore::tIndex index = pStore->_allocate(this);
 
-        // Add altered position vector to parents
-        m_fullPosition += pParent->getWorldPosition();
+    // Keep the absolute position of the roots if the origins of the stores differ
+    Vector3 position = getPosition();
+    if (!getTransforms())
+        position += m_pStore->getOrigin() - pStore->getOrigin();
+
+    pStore->setPosition(index, position);
+    pStore->setOrientation(index, getOrientation());
+    pStore->setScale(index, getScale());
+    pStore->setInheritOrientation(index, inheritOrientation());
+    pStore->setInheritScale(index, inheritScale());
+
+    // Keep the world transforms and the dirty state, so the subtree stays consistent
+    // (see onTransformsChanged())
+    if (!m_pStore->isDirty(m_uiIndex))
+    {
+        pStore->_setWorldTransforms(index, m_pStore->getWorldPosition(m_uiIndex),
+                                    m_pStore->getWorldOrientation(m_uiIndex),
+                                    m_pStore->getWorldScale(m_uiIndex));
+        pStore->_clearDirty(index);
     }
-    else
+
+    m_pStore->_release(m_uiIndex);
+
+    m_pStore = pStore;
+    m_uiIndex = index;
+
+    // Our parent and the Transforms using us might now be in another store
+    updateParentIndex();
+
+    for (tLink* pLink = getFirstLinkBy(); pLink; pLink = pLink->pNextBy)
     {
-        // No parent
-        m_fullPosition      = m_position;
-        m_fullOrientation   = m_orientation;
-        m_fullScale         = m_scale;
+        Transforms* pChild = Transforms::cast(pLink->pFrom);
+        if (pChild && (pChild->getTransforms() == this))
+            pChild->updateParentIndex();
     }
 
-    m_bDirty = false;
+    needUpdate();
+}
+
+//-----------------------------------------------------------------------
+
+void Transforms::_park(TransformsStore* pStore)
+{
+    // Assertions
+    assert(pStore);
+    assert(!_isParked());
+
+    m_pStore->_release(m_uiIndex);
+
+    m_pStore = pStore;
+    m_uiIndex = TransformsStore::INVALID_INDEX;
+}
+
+//-----------------------------------------------------------------------
+
+void Transforms::_unpark()
+{
+    // Assertions
+    assert(_isParked());
+
+    m_uiIndex = m_pStore->_allocate(this);
+
+    updateParentIndex();
+    needUpdate();
+}
+
+//-----------------------------------------------------------------------
+
+void Transforms::updateParentIndex()
+{
+    Transforms* pParent = getTransforms();
+
+    if (!pParent)
+        m_pStore->_setParent(m_uiIndex, TransformsStore::INVALID_INDEX, false);
+    else if (pParent->m_pStore == m_pStore)
+        m_pStore->_setParent(m_uiIndex, pParent->m_uiIndex, false);
+    else
+        m_pStore->_setParent(m_uiIndex, TransformsStore::INVALID_INDEX, true);
 }
 
 
@@ -424,17 +578,28 @@ void Transforms::update()
 
 void Transforms::onTransformsChanged()
 {
-    assert(getSignalsList());
+    // Nothing to do until we get a slot again
+    if (_isParked())
+        return;
+
+    // Our parent might have changed
+    updateParentIndex();
+
+    // If our world transforms are already out-of-date, so are the ones of the whole
+    // subtree, and every component referencing us was already notified since they were
+    // last computed: nothing more to do
+    if (m_pStore->isDirty(m_uiIndex))
+        return;
 
-    m_bDirty = true;
+    m_pStore->_setDirty(m_uiIndex);
+    m_pStore->_trackChange(m_uiIndex);
 
     // Call the base class implementation
     Component::onTransformsChanged();
 
     // Tell all the components that references us about the new transforms
-    tComponentsIterator iter(m_linked_by.begin(), m_linked_by.end());
-    while (iter.hasMoreElements())
-        iter.getNext()->onTransformsChanged();
+    for (tLink* pLink = getFirstLinkBy(); pLink; pLink = pLink->pNextBy)
+        pLink->pFrom->onTransformsChanged();
 }
 
 
@@ -449,19 +614,19 @@ PropertiesList* Transforms::getProperties() const
     pProperties->selectCategory(TYPE, false);
 
     // Position
-    pProperties->set("position", new Variant(m_position));
+    pProperties->set("position", new Variant(getPosition()));
 
     // Orientation
-    pProperties->set("orientation", new Variant(m_orientation));
+    pProperties->set("orientation", new Variant(getOrientation()));
 
     // Scale
-    pProperties->set("scale", new Variant(m_scale));
+    pProperties->set("scale", new Variant(getScale()));
 
     // Inherit orientation
-    pProperties->set("inheritOrientation", new Variant(m_bInheritOrientation));
+    pProperties->set("inheritOrientation", new Variant(inheritOrientation()));
 
     // Inherit scale
-    pProperties->set("inheritScale", new Variant(m_bInheritScale));
+    pProperties->set("inheritScale", new Variant(inheritScale()));
 
     // Returns the list
     return pProperties;
@@ -0,0 +1,710 @@
+/** @file   TransformsStore.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::TransformsStore'
+*/
+
+#include <Athena-Entities/TransformsStore.h>
+#include <Athena-Entities/Transforms.h>
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace std;
+
+
+/************************************** CONSTANTS ***************************************/
+
+/// Index denoting 'no slot'
+const TransformsStore::tIndex TransformsStore::INVALID_INDEX = 0xFFFFFFFF;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+TransformsStore::TransformsStore()
+: m_nbGroups(0), m_nbLevels(0), m_bOrderDirty(false), m_pWorkers(0),
+  m_uiFrame(1), m_uiBatchLevel(0), m_bInterpolationEnabled(false), m_uiCurrentSnapshot(0),
+  m_bChangesTracked(false)
+{
+}
+
+//-----------------------------------------------------------------------
+
+TransformsStore::~TransformsStore()
+{
+    delete m_pWorkers;
+}
+
+//-----------------------------------------------------------------------
+
+TransformsStore* TransformsStore::getDefault()
+{
+    static TransformsStore store;
+    return &store;
+}
+
+
+/************************************** THREADING ***************************************/
+
+void TransformsStore::setNbThreads(unsigned int nbThreads)
+{
+    if (nbThreads == getNbThreads())
+        return;
+
+    delete m_pWorkers;
+    m_pWorkers = 0;
+
+    if (nbThreads != 1)
+        m_pWorkers = new WorkersPool(nbThreads);
+
+    // The slots must be split in another number of groups
+    m_bOrderDirty = true;
+}
+
+
+/******************************* MANAGEMENT OF THE SLOTS ********************************/
+
+TransformsStore::tIndex TransformsStore::_allocate(Transforms* pTransforms)
+{
+    // Assertions
+    assert(pTransforms);
+
+    // Declarations
+    tIndex index;
+
+    // Reuse a free slot if possible, otherwise grow the arrays
+    if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        index = (tIndex) m_owners.size();
+
+        m_positions.push_back(Vector3::ZERO);
+        m_orientations.push_back(Quaternion::IDENTITY);
+        m_scales.push_back(Vector3::UNIT_SCALE);
+        m_worldPositions.push_back(Vector3::ZERO);
+        m_worldOrientations.push_back(Quaternion::IDENTITY);
+        m_worldScales.push_back(Vector3::UNIT_SCALE);
+        m_worldMatrices.push_back(Matrix4::IDENTITY);
+        m_inverseWorldMatrices.push_back(Matrix4::IDENTITY);
+        m_parents.push_back(INVALID_INDEX);
+        m_flags.push_back(0);
+        m_owners.push_back(0);
+        m_changeFrames.push_back(0);
+
+        if ((index >> 5) >= m_dirty.size())
+        {
+            m_dirty.push_back(0);
+            m_changed.push_back(0);
+        }
+
+        if (m_bInterpolationEnabled)
+        {
+            for (unsigned int i = 0; i < 2; ++i)
+            {
+                m_snapshotPositions[i].push_back(Vector3::ZERO);
+                m_snapshotOrientations[i].push_back(Quaternion::IDENTITY);
+                m_snapshotScales[i].push_back(Vector3::UNIT_SCALE);
+            }
+        }
+    }
+
+    // Initialize the slot
+    m_positions[index]          = Vector3::ZERO;
+    m_orientations[index]       = Quaternion::IDENTITY;
+    m_scales[index]             = Vector3::UNIT_SCALE;
+    m_worldPositions[index]     = Vector3::ZERO;
+    m_worldOrientations[index]  = Quaternion::IDENTITY;
+    m_worldScales[index]        = Vector3::UNIT_SCALE;
+    m_parents[index]            = INVALID_INDEX;
+    m_flags[index]              = FLAG_USED | FLAG_INHERIT_ORIENTATION | FLAG_INHERIT_SCALE;
+    m_owners[index]             = pTransforms;
+    m_changeFrames[index]       = m_uiFrame;
+
+    _setDirty(index);
+    _trackChange(index);
+
+    m_bOrderDirty = true;
+
+    return index;
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::_release(tIndex index)
+{
+    // Assertions
+    assert(index < getNbSlots());
+    assert(isUsed(index));
+
+    m_parents[index]    = INVALID_INDEX;
+    m_flags[index]      = 0;
+    m_owners[index]     = 0;
+
+    _clearDirty(index);
+
+    m_freeSlots.push_back(index);
+
+    m_bOrderDirty = true;
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::reserve(unsigned int nbSlots)
+{
+    m_positions.reserve(nbSlots);
+    m_orientations.reserve(nbSlots);
+    m_scales.reserve(nbSlots);
+    m_worldPositions.reserve(nbSlots);
+    m_worldOrientations.reserve(nbSlots);
+    m_worldScales.reserve(nbSlots);
+    m_worldMatrices.reserve(nbSlots);
+    m_inverseWorldMatrices.reserve(nbSlots);
+    m_parents.reserve(nbSlots);
+    m_flags.reserve(nbSlots);
+    m_owners.reserve(nbSlots);
+    m_changeFrames.reserve(nbSlots);
+    m_freeSlots.reserve(nbSlots);
+
+    m_dirty.reserve((nbSlots + 31) >> 5);
+    m_changed.reserve((nbSlots + 31) >> 5);
+
+    if (m_bInterpolationEnabled)
+    {
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            m_snapshotPositions[i].reserve(nbSlots);
+            m_snapshotOrientations[i].reserve(nbSlots);
+            m_snapshotScales[i].reserve(nbSlots);
+        }
+    }
+}
+
+
+/*************************************** BATCHES ****************************************/
+
+void TransformsStore::endBatch()
+{
+    // Assertions
+    assert(m_uiBatchLevel > 0);
+
+    --m_uiBatchLevel;
+    if (m_uiBatchLevel > 0)
+        return;
+
+    // Notify the modifications (the components might start a new batch)
+    std::vector<tIndex> deferred;
+    deferred.swap(m_deferred);
+
+    for (unsigned int i = 0; i < deferred.size(); ++i)
+    {
+        tIndex index = deferred[i];
+
+        // The slot might have been released (and maybe reused) since
+        if (!(m_flags[index] & FLAG_DEFERRED_UPDATE))
+            continue;
+
+        m_flags[index] &= ~FLAG_DEFERRED_UPDATE;
+        m_owners[index]->needUpdate();
+    }
+
+    // Give the memory back for the next batch (unless one was started meanwhile)
+    if (m_deferred.empty())
+    {
+        deferred.clear();
+        deferred.swap(m_deferred);
+    }
+}
+
+
+/************************************ INTERPOLATION *************************************/
+
+void TransformsStore::setInterpolationEnabled(bool bEnabled)
+{
+    if (bEnabled == m_bInterpolationEnabled)
+        return;
+
+    m_bInterpolationEnabled = bEnabled;
+
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        if (bEnabled)
+        {
+            m_snapshotPositions[i].resize(getNbSlots(), Vector3::ZERO);
+            m_snapshotOrientations[i].resize(getNbSlots(), Quaternion::IDENTITY);
+            m_snapshotScales[i].resize(getNbSlots(), Vector3::UNIT_SCALE);
+        }
+        else
+        {
+            std::vector<Vector3>().swap(m_snapshotPositions[i]);
+            std::vector<Quaternion>().swap(m_snapshotOrientations[i]);
+            std::vector<Vector3>().swap(m_snapshotScales[i]);
+        }
+    }
+
+    // No slot has a snapshot yet
+    for (tIndex index = 0; index < getNbSlots(); ++index)
+        m_flags[index] &= ~FLAG_SNAPSHOT;
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::commitFrame()
+{
+    update();
+
+    ++m_uiFrame;
+
+    if (!m_bInterpolationEnabled)
+        return;
+
+    // The last frame becomes the previous one
+    const unsigned int previous = m_uiCurrentSnapshot;
+    const unsigned int current = 1 - m_uiCurrentSnapshot;
+
+    m_uiCurrentSnapshot = current;
+
+    std::copy(m_worldPositions.begin(), m_worldPositions.end(), m_snapshotPositions[current].begin());
+    std::copy(m_worldOrientations.begin(), m_worldOrientations.end(), m_snapshotOrientations[current].begin());
+    std::copy(m_worldScales.begin(), m_worldScales.end(), m_snapshotScales[current].begin());
+
+    // The slots without snapshot don't have a previous frame
+    for (tIndex index = 0; index < getNbSlots(); ++index)
+    {
+        if ((m_flags[index] & (FLAG_USED | FLAG_SNAPSHOT)) == FLAG_USED)
+        {
+            m_snapshotPositions[previous][index]    = m_worldPositions[index];
+            m_snapshotOrientations[previous][index] = m_worldOrientations[index];
+            m_snapshotScales[previous][index]       = m_worldScales[index];
+
+            m_flags[index] |= FLAG_SNAPSHOT;
+        }
+    }
+}
+
+
+/**************************************** ORIGIN ****************************************/
+
+void TransformsStore::rebaseOrigin(const Vector3& offset)
+{
+    enum tState
+    {
+        STATE_UNKNOWN,
+        STATE_SHIFTED,      // Part of a hierarchy whose root belongs to this store
+        STATE_KEPT,         // Part of a hierarchy attached to another store
+    };
+
+    const unsigned int nbSlots = getNbSlots();
+
+    std::vector<unsigned char> states(nbSlots, STATE_UNKNOWN);
+    std::vector<tIndex> path;
+
+    for (tIndex index = 0; index < nbSlots; ++index)
+    {
+        if (!(m_flags[index] & FLAG_USED))
+            continue;
+
+        // Find the state of the root of the hierarchy (or of the first ancestor already
+        // processed), and propagate it to the slots in-between
+        tIndex current = index;
+        while ((states[current] == STATE_UNKNOWN) && (m_parents[current] != INVALID_INDEX))
+        {
+            path.push_back(current);
+            current = m_parents[current];
+        }
+
+        if (states[current] == STATE_UNKNOWN)
+            states[current] = ((m_flags[current] & FLAG_FOREIGN_PARENT) ? STATE_KEPT : STATE_SHIFTED);
+
+        for (unsigned int i = 0; i < path.size(); ++i)
+            states[path[i]] = states[current];
+
+        path.clear();
+
+        if (states[index] != STATE_SHIFTED)
+            continue;
+
+        if (m_parents[index] == INVALID_INDEX)
+            m_positions[index] -= offset;
+
+        // The dirty slots will be computed from the new positions of the roots
+        if (!isDirty(index))
+        {
+            m_worldPositions[index] -= offset;
+            m_flags[index] &= ~(FLAG_WORLD_MATRIX | FLAG_INVERSE_WORLD_MATRIX);
+            m_changeFrames[index] = m_uiFrame;
+        }
+
+        _trackChange(index);
+
+        // Don't interpolate across the rebasing
+        if (m_bInterpolationEnabled && (m_flags[index] & FLAG_SNAPSHOT))
+        {
+            m_snapshotPositions[0][index] -= offset;
+            m_snapshotPositions[1][index] -= offset;
+        }
+    }
+
+    m_origin += offset;
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::getInterpolatedWorldTransforms(tIndex index, Real alpha,
+                                                     Vector3& position,
+                                                     Quaternion& orientation,
+                                                     Vector3& scale, bool bSlerp) const
+{
+    // Assertions
+    assert(index < getNbSlots());
+
+    if (!m_bInterpolationEnabled || !(m_flags[index] & FLAG_SNAPSHOT))
+    {
+        position    = m_worldPositions[index];
+        orientation = m_worldOrientations[index];
+        scale       = m_worldScales[index];
+        return;
+    }
+
+    const unsigned int previous = 1 - m_uiCurrentSnapshot;
+    const unsigned int current = m_uiCurrentSnapshot;
+
+    position = m_snapshotPositions[previous][index] +
+               (m_snapshotPositions[current][index] - m_snapshotPositions[previous][index]) * alpha;
+
+    scale = m_snapshotScales[previous][index] +
+            (m_snapshotScales[current][index] - m_snapshotScales[previous][index]) * alpha;
+
+    if (bSlerp)
+    {
+        orientation = Quaternion::Slerp(alpha, m_snapshotOrientations[previous][index],
+                                        m_snapshotOrientations[current][index], true);
+    }
+    else
+    {
+        orientation = Quaternion::nlerp(alpha, m_snapshotOrientations[previous][index],
+                                        m_snapshotOrientations[current][index], true);
+    }
+}
+
+
+/******************************* TRACKING OF THE CHANGES ********************************/
+
+void TransformsStore::setChangesTracked(bool bTracked)
+{
+    if (bTracked == m_bChangesTracked)
+        return;
+
+    m_bChangesTracked = bTracked;
+
+    std::fill(m_changed.begin(), m_changed.end(), 0u);
+    m_changes.clear();
+
+    // All the slots in use are new for the tracker
+    if (m_bChangesTracked)
+    {
+        for (tIndex index = 0; index < getNbSlots(); ++index)
+        {
+            if (m_flags[index] & FLAG_USED)
+                _trackChange(index);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::_takeChanges(std::vector<tIndex>& changes)
+{
+    changes.clear();
+    changes.swap(m_changes);
+
+    for (unsigned int i = 0; i < changes.size(); ++i)
+        m_changed[changes[i] >> 5] &= ~(1u << (changes[i] & 31));
+}
+
+
+/************************************** HIERARCHY ***************************************/
+
+void TransformsStore::_setParent(tIndex index, tIndex parent, bool bForeign)
+{
+    // Assertions
+    assert(index < getNbSlots());
+    assert((parent == INVALID_INDEX) || (parent < getNbSlots()));
+    assert((parent == INVALID_INDEX) || !bForeign);
+
+    if (m_parents[index] != parent)
+    {
+        m_parents[index] = parent;
+        m_bOrderDirty = true;
+    }
+
+    setFlag(index, FLAG_FOREIGN_PARENT, bForeign);
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::sortSlots(unsigned int nbGroups)
+{
+    // Assertions
+    assert(nbGroups > 0);
+
+    // Declarations
+    const tIndex nbSlots = getNbSlots();
+    std::vector<unsigned int> depths(nbSlots, 0);
+    std::vector<tIndex> roots(nbSlots, INVALID_INDEX);
+    std::vector<unsigned int> sizes(nbSlots, 0);
+    std::vector<tIndex> stack;
+    unsigned int nbLevels = 0;
+    unsigned int nbUsedSlots = 0;
+
+    // Compute the depth and the root of each used slot, walking up the hierarchy until
+    // a slot with a known depth is found
+    for (tIndex index = 0; index < nbSlots; ++index)
+    {
+        if (!isUsed(index))
+            continue;
+
+        if (roots[index] == INVALID_INDEX)
+        {
+            tIndex current = index;
+            while ((current != INVALID_INDEX) && (roots[current] == INVALID_INDEX))
+            {
+                stack.push_back(current);
+                current = m_parents[current];
+            }
+
+            unsigned int depth = (current != INVALID_INDEX ? depths[current] + 1 : 0);
+            tIndex root = (current != INVALID_INDEX ? roots[current] : stack.back());
+
+            while (!stack.empty())
+            {
+                depths[stack.back()] = depth;
+                roots[stack.back()] = root;
+                stack.pop_back();
+                ++depth;
+            }
+        }
+
+        nbLevels = std::max(nbLevels, depths[index] + 1);
+        ++sizes[roots[index]];
+        ++nbUsedSlots;
+    }
+
+    // Assign the subtrees to the groups, so that each group has roughly the same number
+    // of slots
+    std::vector<unsigned int> groups(nbSlots, 0);
+    unsigned int group = 0;
+    unsigned int nbSlotsInGroups = 0;
+
+    for (tIndex index = 0; index < nbSlots; ++index)
+    {
+        if (sizes[index] == 0)
+            continue;
+
+        groups[index] = group;
+        nbSlotsInGroups += sizes[index];
+
+        if ((group + 1 < nbGroups) &&
+            ((unsigned long long) nbSlotsInGroups * nbGroups >= (unsigned long long) nbUsedSlots * (group + 1)))
+        {
+            ++group;
+        }
+    }
+
+    m_nbGroups = (nbUsedSlots > 0 ? std::min(group + 1, nbGroups) : 0);
+    m_nbLevels = nbLevels;
+
+    // Counting sort of the slots by group, then by depth
+    std::vector<unsigned int> counts(m_nbGroups * m_nbLevels, 0);
+
+    for (tIndex index = 0; index < nbSlots; ++index)
+    {
+        if (isUsed(index))
+            ++counts[groups[roots[index]] * m_nbLevels + depths[index]];
+    }
+
+    m_levels.resize(counts.size() + 1);
+
+    unsigned int offset = 0;
+    for (unsigned int level = 0; level < counts.size(); ++level)
+    {
+        unsigned int count = counts[level];
+        counts[level] = offset;
+        m_levels[level] = offset;
+        offset += count;
+    }
+
+    m_levels[counts.size()] = offset;
+    m_order.resize(offset);
+
+    for (tIndex index = 0; index < nbSlots; ++index)
+    {
+        if (isUsed(index))
+            m_order[counts[groups[roots[index]] * m_nbLevels + depths[index]]++] = index;
+    }
+
+    m_batches.resize(m_nbGroups);
+
+    m_bOrderDirty = false;
+}
+
+
+/*********************************** WORLD TRANSFORMS ***********************************/
+
+void TransformsStore::_computeWorldTransforms(tIndex index)
+{
+    computeWorldTransforms(index);
+    _clearDirty(index);
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::_computeWorldTransforms(tIndex index, const Vector3& parentPosition,
+                                              const Quaternion& parentOrientation,
+                                              const Vector3& parentScale)
+{
+    computeWorldTransforms(index, parentPosition, parentOrientation, parentScale);
+    _clearDirty(index);
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::computeWorldTransforms(tIndex index)
+{
+    // Assertions
+    assert(index < getNbSlots());
+
+    // No parent
+    m_worldPositions[index]     = m_positions[index];
+    m_worldOrientations[index]  = m_orientations[index];
+    m_worldScales[index]        = m_scales[index];
+
+    m_flags[index] &= ~(FLAG_WORLD_MATRIX | FLAG_INVERSE_WORLD_MATRIX);
+    m_changeFrames[index] = m_uiFrame;
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::computeWorldTransforms(tIndex index, const Vector3& parentPosition,
+                                              const Quaternion& parentOrientation,
+                                              const Vector3& parentScale)
+{
+    // Assertions
+    assert(index < getNbSlots());
+
+    // Update orientation
+    if (m_flags[index] & FLAG_INHERIT_ORIENTATION)
+    {
+        // Combine orientation with that of parent
+        m_worldOrientations[index] = parentOrientation * m_orientations[index];
+        m_worldOrientations[index].normalise();
+    }
+    else
+    {
+        // No inheritence
+        m_worldOrientations[index] = m_orientations[index];
+    }
+
+    // Update scale
+    if (m_flags[index] & FLAG_INHERIT_SCALE)
+    {
+        // Scale own position by parent scale, NB just combine
+        // as equivalent axes, no shearing
+        m_worldScales[index] = parentScale * m_scales[index];
+    }
+    else
+    {
+        // No inheritence
+        m_worldScales[index] = m_scales[index];
+    }
+
+    // Change position vector based on parent's orientation & scale, and add altered
+    // position vector to parents
+    m_worldPositions[index] = parentOrientation * (parentScale * m_positions[index]) + parentPosition;
+
+    m_flags[index] &= ~(FLAG_WORLD_MATRIX | FLAG_INVERSE_WORLD_MATRIX);
+    m_changeFrames[index] = m_uiFrame;
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::update()
+{
+    // Split the subtrees in several groups per thread, to balance the load
+    if (m_bOrderDirty)
+        sortSlots(m_pWorkers ? m_pWorkers->getNbThreads() * 4 : 1);
+
+    // The slots whose parent isn't part of this store ask it for its world transforms,
+    // which might trigger computations in other stores: this isn't done in parallel
+    for (unsigned int group = 0; group < m_nbGroups; ++group)
+    {
+        for (unsigned int i = m_levels[group * m_nbLevels]; i < m_levels[group * m_nbLevels + 1]; ++i)
+        {
+            tIndex index = m_order[i];
+
+            if (isDirty(index) && (m_flags[index] & FLAG_FOREIGN_PARENT))
+            {
+                Transforms* pParent = m_owners[index]->getTransforms();
+                assert(pParent);
+
+                _computeWorldTransforms(index, pParent->getWorldPosition(),
+                                        pParent->getWorldOrientation(), pParent->getWorldScale());
+            }
+        }
+    }
+
+    // Process the groups (in parallel if possible)
+    if (m_pWorkers)
+        m_pWorkers->run(&TransformsStore::updateGroupTask, this, m_nbGroups);
+    else if (m_nbGroups > 0)
+        updateGroup(0);
+
+    // All the dirty slots were processed. Clearing the dirty bits in the groups would
+    // write in words shared between them.
+    std::fill(m_dirty.begin(), m_dirty.end(), 0u);
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::updateGroup(unsigned int group)
+{
+    // Assertions
+    assert(group < m_nbGroups);
+
+    // Declarations
+    std::vector<tIndex>& batch = m_batches[group];
+
+    // Process the slots level by level: the parents (if any) were already processed
+    for (unsigned int level = group * m_nbLevels; level < (group + 1) * m_nbLevels; ++level)
+    {
+        batch.clear();
+
+        for (unsigned int i = m_levels[level]; i < m_levels[level + 1]; ++i)
+        {
+            tIndex index = m_order[i];
+
+            if (!isDirty(index))
+                continue;
+
+            // The parent belongs to this store
+            if (m_parents[index] != INVALID_INDEX)
+                batch.push_back(index);
+
+            // No parent (the slots with a parent in another store were already processed)
+            else if (!(m_flags[index] & FLAG_FOREIGN_PARENT))
+                computeWorldTransforms(index);
+        }
+
+        if (!batch.empty())
+            computeWorldTransformsBatch(&batch[0], (unsigned int) batch.size());
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void TransformsStore::updateGroupTask(void* pUserData, unsigned int task)
+{
+    static_cast<TransformsStore*>(pUserData)->updateGroup(task);
+}
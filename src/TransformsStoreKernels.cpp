@@ -0,0 +1,291 @@
+/** @file   TransformsStoreKernels.cpp
+    @author Philip Abbet
+
+    Implementation of the batched computation of the world transforms of the class
+    'Athena::Entities::TransformsStore', using SIMD instructions (AVX or SSE) when they
+    are enabled and supported by the compiler settings
+*/
+
+#include <Athena-Entities/TransformsStore.h>
+
+#if ATHENA_ENTITIES_SIMD && defined(__AVX__)
+#   include <immintrin.h>
+#   define ATHENA_ENTITIES_SIMD_AVX 1
+#elif ATHENA_ENTITIES_SIMD && (defined(__SSE2__) || defined(_M_X64) || \
+                               (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#   include <emmintrin.h>
+#   define ATHENA_ENTITIES_SIMD_SSE 1
+#endif
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+using namespace std;
+
+
+/************************************** SIMD LANES **************************************/
+
+// Each backend provides the same set of operations on a group of LANES floats, so the
+// kernel below is written only once
+
+#if ATHENA_ENTITIES_SIMD_AVX
+
+typedef __m256 tLanes;
+
+static const unsigned int LANES = 8;
+
+static inline tLanes lanesLoad(const float* p)              { return _mm256_loadu_ps(p); }
+static inline void lanesStore(float* p, tLanes a)           { _mm256_storeu_ps(p, a); }
+static inline tLanes lanesAdd(tLanes a, tLanes b)           { return _mm256_add_ps(a, b); }
+static inline tLanes lanesSub(tLanes a, tLanes b)           { return _mm256_sub_ps(a, b); }
+static inline tLanes lanesMul(tLanes a, tLanes b)           { return _mm256_mul_ps(a, b); }
+static inline tLanes lanesDiv(tLanes a, tLanes b)           { return _mm256_div_ps(a, b); }
+static inline tLanes lanesSqrt(tLanes a)                    { return _mm256_sqrt_ps(a); }
+static inline tLanes lanesSet(float f)                      { return _mm256_set1_ps(f); }
+
+// Returns a mask selecting the non-zero lanes
+static inline tLanes lanesMask(tLanes a)
+{
+    return _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_OQ);
+}
+
+// Returns 'a' in the lanes selected by the mask, 'b' in the others
+static inline tLanes lanesSelect(tLanes mask, tLanes a, tLanes b)
+{
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+#elif ATHENA_ENTITIES_SIMD_SSE
+
+typedef __m128 tLanes;
+
+static const unsigned int LANES = 4;
+
+static inline tLanes lanesLoad(const float* p)              { return _mm_loadu_ps(p); }
+static inline void lanesStore(float* p, tLanes a)           { _mm_storeu_ps(p, a); }
+static inline tLanes lanesAdd(tLanes a, tLanes b)           { return _mm_add_ps(a, b); }
+static inline tLanes lanesSub(tLanes a, tLanes b)           { return _mm_sub_ps(a, b); }
+static inline tLanes lanesMul(tLanes a, tLanes b)           { return _mm_mul_ps(a, b); }
+static inline tLanes lanesDiv(tLanes a, tLanes b)           { return _mm_div_ps(a, b); }
+static inline tLanes lanesSqrt(tLanes a)                    { return _mm_sqrt_ps(a); }
+static inline tLanes lanesSet(float f)                      { return _mm_set1_ps(f); }
+
+// Returns a mask selecting the non-zero lanes
+static inline tLanes lanesMask(tLanes a)
+{
+    return _mm_cmpneq_ps(a, _mm_setzero_ps());
+}
+
+// Returns 'a' in the lanes selected by the mask, 'b' in the others
+static inline tLanes lanesSelect(tLanes mask, tLanes a, tLanes b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+#else
+
+static const unsigned int LANES = 1;
+
+#endif
+
+
+/************************************** CONSTANTS ***************************************/
+
+/// Number of slots processed at once by update()
+const unsigned int TransformsStore::SIMD_WIDTH = LANES;
+
+
+/*************************************** KERNEL *****************************************/
+
+#if ATHENA_ENTITIES_SIMD_AVX || ATHENA_ENTITIES_SIMD_SSE
+
+/// Transforms of LANES slots, in structure-of-arrays form
+struct tBatch
+{
+    float parentOrientation[4][LANES];  ///< w, x, y, z
+    float parentScale[3][LANES];
+    float parentPosition[3][LANES];
+    float orientation[4][LANES];        ///< In: local, out: world
+    float scale[3][LANES];              ///< In: local, out: world
+    float position[3][LANES];           ///< In: local, out: world
+    float inheritOrientation[LANES];    ///< 1.0f or 0.0f
+    float inheritScale[LANES];          ///< 1.0f or 0.0f
+};
+
+//-----------------------------------------------------------------------
+
+// Same computation than TransformsStore::_computeWorldTransforms(), on LANES slots
+static void composeTransforms(tBatch& batch)
+{
+    // Load the parent transforms
+    tLanes pw = lanesLoad(batch.parentOrientation[0]);
+    tLanes px = lanesLoad(batch.parentOrientation[1]);
+    tLanes py = lanesLoad(batch.parentOrientation[2]);
+    tLanes pz = lanesLoad(batch.parentOrientation[3]);
+
+    tLanes psx = lanesLoad(batch.parentScale[0]);
+    tLanes psy = lanesLoad(batch.parentScale[1]);
+    tLanes psz = lanesLoad(batch.parentScale[2]);
+
+    // Orientation: combine with the one of the parent, and normalise
+    tLanes qw = lanesLoad(batch.orientation[0]);
+    tLanes qx = lanesLoad(batch.orientation[1]);
+    tLanes qy = lanesLoad(batch.orientation[2]);
+    tLanes qz = lanesLoad(batch.orientation[3]);
+
+    tLanes rw = lanesSub(lanesSub(lanesSub(lanesMul(pw, qw), lanesMul(px, qx)), lanesMul(py, qy)), lanesMul(pz, qz));
+    tLanes rx = lanesSub(lanesAdd(lanesAdd(lanesMul(pw, qx), lanesMul(px, qw)), lanesMul(py, qz)), lanesMul(pz, qy));
+    tLanes ry = lanesSub(lanesAdd(lanesAdd(lanesMul(pw, qy), lanesMul(py, qw)), lanesMul(pz, qx)), lanesMul(px, qz));
+    tLanes rz = lanesSub(lanesAdd(lanesAdd(lanesMul(pw, qz), lanesMul(pz, qw)), lanesMul(px, qy)), lanesMul(py, qx));
+
+    tLanes norm = lanesAdd(lanesAdd(lanesMul(rw, rw), lanesMul(rx, rx)),
+                           lanesAdd(lanesMul(ry, ry), lanesMul(rz, rz)));
+    tLanes factor = lanesDiv(lanesSet(1.0f), lanesSqrt(norm));
+
+    tLanes inheritOrientation = lanesMask(lanesLoad(batch.inheritOrientation));
+
+    lanesStore(batch.orientation[0], lanesSelect(inheritOrientation, lanesMul(rw, factor), qw));
+    lanesStore(batch.orientation[1], lanesSelect(inheritOrientation, lanesMul(rx, factor), qx));
+    lanesStore(batch.orientation[2], lanesSelect(inheritOrientation, lanesMul(ry, factor), qy));
+    lanesStore(batch.orientation[3], lanesSelect(inheritOrientation, lanesMul(rz, factor), qz));
+
+    // Scale: combine with the one of the parent
+    tLanes sx = lanesLoad(batch.scale[0]);
+    tLanes sy = lanesLoad(batch.scale[1]);
+    tLanes sz = lanesLoad(batch.scale[2]);
+
+    tLanes inheritScale = lanesMask(lanesLoad(batch.inheritScale));
+
+    lanesStore(batch.scale[0], lanesSelect(inheritScale, lanesMul(psx, sx), sx));
+    lanesStore(batch.scale[1], lanesSelect(inheritScale, lanesMul(psy, sy), sy));
+    lanesStore(batch.scale[2], lanesSelect(inheritScale, lanesMul(psz, sz), sz));
+
+    // Position: scale by the parent scale, rotate by the parent orientation, and add the
+    // parent position
+    tLanes vx = lanesMul(psx, lanesLoad(batch.position[0]));
+    tLanes vy = lanesMul(psy, lanesLoad(batch.position[1]));
+    tLanes vz = lanesMul(psz, lanesLoad(batch.position[2]));
+
+    // uv = qvec x v
+    tLanes uvx = lanesSub(lanesMul(py, vz), lanesMul(pz, vy));
+    tLanes uvy = lanesSub(lanesMul(pz, vx), lanesMul(px, vz));
+    tLanes uvz = lanesSub(lanesMul(px, vy), lanesMul(py, vx));
+
+    // uuv = qvec x uv
+    tLanes uuvx = lanesSub(lanesMul(py, uvz), lanesMul(pz, uvy));
+    tLanes uuvy = lanesSub(lanesMul(pz, uvx), lanesMul(px, uvz));
+    tLanes uuvz = lanesSub(lanesMul(px, uvy), lanesMul(py, uvx));
+
+    // v + uv * 2w + uuv * 2
+    tLanes two = lanesSet(2.0f);
+    tLanes w2 = lanesMul(pw, two);
+
+    vx = lanesAdd(lanesAdd(vx, lanesMul(uvx, w2)), lanesMul(uuvx, two));
+    vy = lanesAdd(lanesAdd(vy, lanesMul(uvy, w2)), lanesMul(uuvy, two));
+    vz = lanesAdd(lanesAdd(vz, lanesMul(uvz, w2)), lanesMul(uuvz, two));
+
+    lanesStore(batch.position[0], lanesAdd(vx, lanesLoad(batch.parentPosition[0])));
+    lanesStore(batch.position[1], lanesAdd(vy, lanesLoad(batch.parentPosition[1])));
+    lanesStore(batch.position[2], lanesAdd(vz, lanesLoad(batch.parentPosition[2])));
+}
+
+#endif
+
+
+/*********************************** WORLD TRANSFORMS ***********************************/
+
+void TransformsStore::computeWorldTransformsBatch(const tIndex* pIndices,
+                                                  unsigned int nbIndices)
+{
+    // Assertions
+    assert(pIndices);
+
+#if ATHENA_ENTITIES_SIMD_AVX || ATHENA_ENTITIES_SIMD_SSE
+
+    // The kernel works on single-precision values only
+    if (sizeof(Real) == sizeof(float))
+    {
+        // Declarations
+        tBatch batch;
+
+        for (unsigned int offset = 0; offset < nbIndices; offset += LANES)
+        {
+            unsigned int count = std::min(LANES, nbIndices - offset);
+
+            // Gather the data of the slots (the unused lanes are filled with the last slot)
+            for (unsigned int lane = 0; lane < LANES; ++lane)
+            {
+                tIndex index = pIndices[offset + std::min(lane, count - 1)];
+                tIndex parent = m_parents[index];
+
+                assert(parent != INVALID_INDEX);
+
+                const Quaternion& parentOrientation = m_worldOrientations[parent];
+                const Vector3& parentScale = m_worldScales[parent];
+                const Vector3& parentPosition = m_worldPositions[parent];
+                const Quaternion& orientation = m_orientations[index];
+                const Vector3& scale = m_scales[index];
+                const Vector3& position = m_positions[index];
+
+                batch.parentOrientation[0][lane] = parentOrientation.w;
+                batch.parentOrientation[1][lane] = parentOrientation.x;
+                batch.parentOrientation[2][lane] = parentOrientation.y;
+                batch.parentOrientation[3][lane] = parentOrientation.z;
+                batch.parentScale[0][lane] = parentScale.x;
+                batch.parentScale[1][lane] = parentScale.y;
+                batch.parentScale[2][lane] = parentScale.z;
+                batch.parentPosition[0][lane] = parentPosition.x;
+                batch.parentPosition[1][lane] = parentPosition.y;
+                batch.parentPosition[2][lane] = parentPosition.z;
+                batch.orientation[0][lane] = orientation.w;
+                batch.orientation[1][lane] = orientation.x;
+                batch.orientation[2][lane] = orientation.y;
+                batch.orientation[3][lane] = orientation.z;
+                batch.scale[0][lane] = scale.x;
+                batch.scale[1][lane] = scale.y;
+                batch.scale[2][lane] = scale.z;
+                batch.position[0][lane] = position.x;
+                batch.position[1][lane] = position.y;
+                batch.position[2][lane] = position.z;
+                batch.inheritOrientation[lane] = ((m_flags[index] & FLAG_INHERIT_ORIENTATION) ? 1.0f : 0.0f);
+                batch.inheritScale[lane] = ((m_flags[index] & FLAG_INHERIT_SCALE) ? 1.0f : 0.0f);
+            }
+
+            composeTransforms(batch);
+
+            // Scatter the results
+            for (unsigned int lane = 0; lane < count; ++lane)
+            {
+                tIndex index = pIndices[offset + lane];
+
+                m_worldOrientations[index] = Quaternion(batch.orientation[0][lane],
+                                                        batch.orientation[1][lane],
+                                                        batch.orientation[2][lane],
+                                                        batch.orientation[3][lane]);
+                m_worldScales[index] = Vector3(batch.scale[0][lane], batch.scale[1][lane],
+                                               batch.scale[2][lane]);
+                m_worldPositions[index] = Vector3(batch.position[0][lane],
+                                                  batch.position[1][lane],
+                                                  batch.position[2][lane]);
+
+                m_flags[index] &= ~(FLAG_WORLD_MATRIX | FLAG_INVERSE_WORLD_MATRIX);
+                m_changeFrames[index] = m_uiFrame;
+            }
+        }
+
+        return;
+    }
+
+#endif
+
+    // Scalar fallback
+    for (unsigned int i = 0; i < nbIndices; ++i)
+    {
+        tIndex index = pIndices[i];
+        tIndex parent = m_parents[index];
+
+        assert(parent != INVALID_INDEX);
+
+        computeWorldTransforms(index, m_worldPositions[parent], m_worldOrientations[parent],
+                               m_worldScales[parent]);
+    }
+}
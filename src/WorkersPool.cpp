@@ -0,0 +1,123 @@
+/** @file   WorkersPool.cpp
+    @author Philip Abbet
+
+    Implementation of the class 'Athena::Entities::WorkersPool'
+*/
+
+#include <Athena-Entities/WorkersPool.h>
+
+using namespace Athena::Entities;
+using namespace std;
+
+
+/***************************** CONSTRUCTION / DESTRUCTION *******************************/
+
+WorkersPool::WorkersPool(unsigned int nbThreads)
+: m_function(0), m_pUserData(0), m_nbTasks(0), m_nextTask(0), m_nbBusyWorkers(0),
+  m_uiGeneration(0), m_bQuit(false)
+{
+    if (nbThreads == 0)
+        nbThreads = std::max(thread::hardware_concurrency(), 1u);
+
+    // The calling thread is one of the workers
+    for (unsigned int i = 1; i < nbThreads; ++i)
+        m_threads.push_back(thread(&WorkersPool::workerMain, this));
+}
+
+//-----------------------------------------------------------------------
+
+WorkersPool::~WorkersPool()
+{
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_bQuit = true;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (unsigned int i = 0; i < m_threads.size(); ++i)
+        m_threads[i].join();
+}
+
+
+/**************************************** METHODS ***************************************/
+
+void WorkersPool::run(tTaskFunction function, void* pUserData, unsigned int nbTasks)
+{
+    // Assertions
+    assert(function);
+
+    if (nbTasks == 0)
+        return;
+
+    // No need to wake up the workers for one task
+    if (m_threads.empty() || (nbTasks == 1))
+    {
+        for (unsigned int i = 0; i < nbTasks; ++i)
+            function(pUserData, i);
+
+        return;
+    }
+
+    {
+        unique_lock<mutex> lock(m_mutex);
+
+        m_function      = function;
+        m_pUserData     = pUserData;
+        m_nbTasks       = nbTasks;
+        m_nextTask      = 0;
+        m_nbBusyWorkers = (unsigned int) m_threads.size();
+
+        ++m_uiGeneration;
+    }
+
+    m_wakeUp.notify_all();
+
+    processTasks();
+
+    // Wait for the workers
+    unique_lock<mutex> lock(m_mutex);
+    while (m_nbBusyWorkers > 0)
+        m_done.wait(lock);
+}
+
+//-----------------------------------------------------------------------
+
+void WorkersPool::workerMain()
+{
+    unsigned int generation = 0;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+
+            while (!m_bQuit && (m_uiGeneration == generation))
+                m_wakeUp.wait(lock);
+
+            if (m_bQuit)
+                return;
+
+            generation = m_uiGeneration;
+        }
+
+        processTasks();
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+
+            --m_nbBusyWorkers;
+            if (m_nbBusyWorkers == 0)
+                m_done.notify_one();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------
+
+void WorkersPool::processTasks()
+{
+    unsigned int task;
+    while ((task = m_nextTask++) < m_nbTasks)
+        m_function(m_pUserData, task);
+}
@@ -0,0 +1,100 @@
+/** @file   tSymbol.cpp
+    @author Philip Abbet
+
+    Implementation of the type 'Athena::Entities::tSymbol'
+*/
+
+#include <Athena-Entities/tSymbol.h>
+#include <unordered_map>
+#include <mutex>
+#include <tuple>
+
+using namespace Athena::Entities;
+using namespace std;
+
+
+/************************************** CONSTANTS ***************************************/
+
+const std::string tSymbol::EMPTY;
+
+
+/********************************** PRIVATE FUNCTIONS ***********************************/
+
+typedef unordered_map<string, atomic<unsigned int> > tSymbolsTable;
+
+// The table is never destroyed: symbols can still be used during the destruction of the
+// static objects
+static tSymbolsTable& getTable()
+{
+    static tSymbolsTable* pTable = new tSymbolsTable();
+    return *pTable;
+}
+
+//-----------------------------------------------------------------------
+
+static mutex& getMutex()
+{
+    static mutex* pMutex = new mutex();
+    return *pMutex;
+}
+
+
+/*************************************** METHODS ****************************************/
+
+tSymbol::tEntry* tSymbol::intern(const char* str, size_t length)
+{
+    if (length == 0)
+        return 0;
+
+    static string key;
+
+    lock_guard<mutex> lock(getMutex());
+
+    // Reuse the buffer of the key, to not allocate memory when the string is already known
+    key.assign(str, length);
+
+    tSymbolsTable& table = getTable();
+
+    tSymbolsTable::iterator iter = table.find(key);
+    if (iter == table.end())
+        iter = table.emplace(piecewise_construct, forward_as_tuple(key), forward_as_tuple(0u)).first;
+
+    iter->second.fetch_add(1, memory_order_relaxed);
+
+    return &(*iter);
+}
+
+//-----------------------------------------------------------------------
+
+void tSymbol::release(tEntry* pEntry)
+{
+    // Assertions
+    assert(pEntry);
+
+    // Without the mutex while other references remain: the count can't reach zero, and
+    // the entry can't be removed
+    unsigned int uiRefCount = pEntry->second.load(memory_order_relaxed);
+    while (uiRefCount > 1)
+    {
+        if (pEntry->second.compare_exchange_weak(uiRefCount, uiRefCount - 1,
+                                                 memory_order_acq_rel))
+        {
+            return;
+        }
+    }
+
+    // Possibly the last reference: decide under the mutex, so intern() can't give a new
+    // reference to the entry at the same time
+    lock_guard<mutex> lock(getMutex());
+
+    if (pEntry->second.fetch_sub(1, memory_order_acq_rel) == 1)
+        getTable().erase(pEntry->first);
+}
+
+//-----------------------------------------------------------------------
+
+unsigned int tSymbol::getNbStrings()
+{
+    lock_guard<mutex> lock(getMutex());
+    return (unsigned int) getTable().size();
+}
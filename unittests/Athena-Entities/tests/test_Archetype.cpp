@@ -0,0 +1,142 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/Archetype.h>
+
+
+using namespace Athena::Entities;
+
+
+// The archetypes only reference the entities and components, fake addresses are enough
+static Entity* fakeEntity(unsigned int index)
+{
+    static char entities[256];
+    return (Entity*) &entities[index];
+}
+
+static Component* fakeComponent(unsigned int index)
+{
+    static char components[1024];
+    return (Component*) &components[index];
+}
+
+
+static Archetype::tSignature createSignature(Component::tTypeID type1, Component::tTypeID type2)
+{
+    Archetype::tSignature signature;
+    signature.push_back(type1);
+    signature.push_back(type2);
+    return signature;
+}
+
+
+SUITE(ArchetypeTests)
+{
+    TEST(Creation)
+    {
+        Archetype archetype(createSignature(1, 3));
+
+        CHECK_EQUAL(2, archetype.getSignature().size());
+        CHECK_EQUAL(0, archetype.getNbEntities());
+        CHECK_EQUAL(0, archetype.getNbChunks());
+    }
+
+
+    TEST(Columns)
+    {
+        Archetype::tSignature signature = createSignature(1, 3);
+        signature.push_back(3);
+
+        Archetype archetype(signature);
+
+        CHECK_EQUAL(0, archetype.getColumn(1));
+        CHECK_EQUAL(1, archetype.getColumn(3));
+        CHECK_EQUAL(2, archetype.getColumn(3, 1));
+        CHECK_EQUAL(Archetype::INVALID_COLUMN, archetype.getColumn(3, 2));
+        CHECK_EQUAL(Archetype::INVALID_COLUMN, archetype.getColumn(2));
+
+        CHECK(archetype.hasType(1));
+        CHECK(!archetype.hasType(2));
+    }
+
+
+    TEST(AddEntities)
+    {
+        Archetype archetype(createSignature(1, 3));
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            Component* components[] = { fakeComponent(i * 2), fakeComponent(i * 2 + 1) };
+            CHECK_EQUAL(i, archetype._addEntity(fakeEntity(i), components));
+        }
+
+        CHECK_EQUAL(3, archetype.getNbEntities());
+        CHECK_EQUAL(1, archetype.getNbChunks());
+        CHECK_EQUAL(3, archetype.getNbEntities(0));
+
+        Entity* const* entities = archetype.getEntities(0);
+        Component* const* components1 = archetype.getComponents(0, 0);
+        Component* const* components3 = archetype.getComponents(0, 1);
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            CHECK_EQUAL(fakeEntity(i), entities[i]);
+            CHECK_EQUAL(fakeComponent(i * 2), components1[i]);
+            CHECK_EQUAL(fakeComponent(i * 2 + 1), components3[i]);
+        }
+    }
+
+
+    TEST(RemoveEntity)
+    {
+        Archetype archetype(createSignature(1, 3));
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            Component* components[] = { fakeComponent(i * 2), fakeComponent(i * 2 + 1) };
+            archetype._addEntity(fakeEntity(i), components);
+        }
+
+        // The last entity is moved in the hole
+        CHECK_EQUAL(fakeEntity(2), archetype._removeEntity(0));
+
+        CHECK_EQUAL(2, archetype.getNbEntities());
+        CHECK_EQUAL(fakeEntity(2), archetype.getEntities(0)[0]);
+        CHECK_EQUAL(fakeComponent(4), archetype.getComponents(0, 0)[0]);
+        CHECK_EQUAL(fakeComponent(5), archetype.getComponents(0, 1)[0]);
+        CHECK_EQUAL(fakeEntity(1), archetype.getEntities(0)[1]);
+
+        // Nothing to move when the last entity is removed
+        CHECK(!archetype._removeEntity(1));
+        CHECK_EQUAL(1, archetype.getNbEntities());
+
+        CHECK(!archetype._removeEntity(0));
+        CHECK_EQUAL(0, archetype.getNbEntities());
+        CHECK_EQUAL(0, archetype.getNbChunks());
+    }
+
+
+    TEST(SeveralChunks)
+    {
+        Archetype archetype(createSignature(1, 3));
+
+        for (unsigned int i = 0; i < Archetype::CHUNK_SIZE + 1; ++i)
+        {
+            Component* components[] = { fakeComponent(i * 2), fakeComponent(i * 2 + 1) };
+            archetype._addEntity(fakeEntity(i), components);
+        }
+
+        CHECK_EQUAL(Archetype::CHUNK_SIZE + 1, archetype.getNbEntities());
+        CHECK_EQUAL(2, archetype.getNbChunks());
+        CHECK_EQUAL(Archetype::CHUNK_SIZE, archetype.getNbEntities(0));
+        CHECK_EQUAL(1, archetype.getNbEntities(1));
+        CHECK_EQUAL(fakeEntity(Archetype::CHUNK_SIZE), archetype.getEntities(1)[0]);
+        CHECK_EQUAL(fakeComponent(Archetype::CHUNK_SIZE * 2 + 1), archetype.getComponents(1, 1)[0]);
+
+        // The entity of the last chunk fills the hole, and the chunk is released
+        CHECK_EQUAL(fakeEntity(Archetype::CHUNK_SIZE), archetype._removeEntity(5));
+
+        CHECK_EQUAL(Archetype::CHUNK_SIZE, archetype.getNbEntities());
+        CHECK_EQUAL(1, archetype.getNbChunks());
+        CHECK_EQUAL(fakeEntity(Archetype::CHUNK_SIZE), archetype.getEntities(0)[5]);
+        CHECK_EQUAL(fakeComponent(Archetype::CHUNK_SIZE * 2), archetype.getComponents(0, 0)[5]);
+    }
+}
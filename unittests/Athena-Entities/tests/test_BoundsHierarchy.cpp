@@ -0,0 +1,241 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/BoundsHierarchy.h>
+#include <Athena-Entities/Scene.h>
+#include <sstream>
+#include <algorithm>
+#include "../environments/EntitiesTestEnvironment.h"
+
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+
+
+// The entries of the hierarchy are identified by the handles of the entities
+static Entity* createEntity(Scene* pScene, unsigned int index)
+{
+    std::ostringstream str;
+    str << "entity" << index;
+    return pScene->create(str.str());
+}
+
+
+// Unit box centered on a position
+static tBounds unitBox(const Vector3& center)
+{
+    return tBounds(center - Vector3(0.5f, 0.5f, 0.5f), center + Vector3(0.5f, 0.5f, 0.5f));
+}
+
+
+// Frustum of an orthographic camera looking along the Z axis, containing the points
+// between 'min' and 'max'
+static tFrustum boxFrustum(const Vector3& min, const Vector3& max)
+{
+    tFrustum frustum;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        frustum.planes[i * 2].normal = Vector3::ZERO;
+        frustum.planes[i * 2].normal[i] = 1.0f;
+        frustum.planes[i * 2].d = -min[i];
+
+        frustum.planes[i * 2 + 1].normal = Vector3::ZERO;
+        frustum.planes[i * 2 + 1].normal[i] = -1.0f;
+        frustum.planes[i * 2 + 1].d = max[i];
+    }
+
+    return frustum;
+}
+
+
+SUITE(BoundsHierarchyTests)
+{
+    TEST(BoundsTransformation)
+    {
+        tBounds bounds(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+
+        Matrix4 matrix;
+        matrix.makeTransform(Vector3(10.0f, 0.0f, 0.0f), Vector3(2.0f, 2.0f, 2.0f),
+                             Quaternion(Degree(90.0f), Vector3::UNIT_Y));
+
+        tBounds result = bounds.transformed(matrix);
+
+        CHECK(Vector3(4.0f, -4.0f, -2.0f).positionEquals(result.min));
+        CHECK(Vector3(16.0f, 4.0f, 2.0f).positionEquals(result.max));
+    }
+
+
+    TEST(FrustumFromMatrix)
+    {
+        // Orthographic projection of the box [-10, 10] x [-5, 5] x [-100, -1]
+        Matrix4 projection(0.1f, 0.0f, 0.0f, 0.0f,
+                           0.0f, 0.2f, 0.0f, 0.0f,
+                           0.0f, 0.0f, -2.0f / 99.0f, -101.0f / 99.0f,
+                           0.0f, 0.0f, 0.0f, 1.0f);
+
+        tFrustum frustum = tFrustum::fromMatrix(projection);
+
+        CHECK_EQUAL(tFrustum::INSIDE, frustum.classify(unitBox(Vector3(0.0f, 0.0f, -50.0f))));
+        CHECK_EQUAL(tFrustum::INTERSECTING, frustum.classify(unitBox(Vector3(10.0f, 0.0f, -50.0f))));
+        CHECK_EQUAL(tFrustum::OUTSIDE, frustum.classify(unitBox(Vector3(0.0f, 6.0f, -50.0f))));
+        CHECK_EQUAL(tFrustum::OUTSIDE, frustum.classify(unitBox(Vector3(0.0f, 0.0f, 10.0f))));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, AddEntities)
+    {
+        BoundsHierarchy hierarchy;
+
+        CHECK_EQUAL(0, hierarchy.getNbEntities());
+        CHECK_EQUAL(0, hierarchy.getDepth());
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+        Entity* pEntity3 = createEntity(pScene, 3);
+
+        hierarchy._update(pEntity1, unitBox(Vector3(0.0f, 0.0f, 0.0f)));
+        CHECK_EQUAL(1, hierarchy.getDepth());
+
+        hierarchy._update(pEntity2, unitBox(Vector3(10.0f, 0.0f, 0.0f)));
+        hierarchy._update(pEntity3, unitBox(Vector3(0.0f, 10.0f, 0.0f)));
+
+        CHECK_EQUAL(3, hierarchy.getNbEntities());
+        CHECK(hierarchy.contains(pEntity2));
+        CHECK(unitBox(Vector3(10.0f, 0.0f, 0.0f)) == hierarchy.getBounds(pEntity2));
+
+        CHECK(Vector3(-0.5f, -0.5f, -0.5f).positionEquals(hierarchy.getBounds().min));
+        CHECK(Vector3(10.5f, 10.5f, 0.5f).positionEquals(hierarchy.getBounds().max));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, UpdateEntity)
+    {
+        BoundsHierarchy hierarchy;
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+
+        hierarchy._update(pEntity1, unitBox(Vector3(0.0f, 0.0f, 0.0f)));
+        hierarchy._update(pEntity2, unitBox(Vector3(10.0f, 0.0f, 0.0f)));
+
+        // Inside its parent: refitted
+        hierarchy._update(pEntity1, unitBox(Vector3(1.0f, 0.0f, 0.0f)));
+        CHECK(Vector3(0.5f, -0.5f, -0.5f).positionEquals(hierarchy.getBounds().min));
+
+        // Outside its parent: reinserted
+        hierarchy._update(pEntity1, unitBox(Vector3(-20.0f, 0.0f, 0.0f)));
+
+        CHECK_EQUAL(2, hierarchy.getNbEntities());
+        CHECK_EQUAL(2, hierarchy.getDepth());
+        CHECK(Vector3(-20.5f, -0.5f, -0.5f).positionEquals(hierarchy.getBounds().min));
+        CHECK(Vector3(10.5f, 0.5f, 0.5f).positionEquals(hierarchy.getBounds().max));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RemoveEntity)
+    {
+        BoundsHierarchy hierarchy;
+
+        Entity* entities[10];
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            entities[i] = createEntity(pScene, i);
+            hierarchy._update(entities[i], unitBox(Vector3(i * 10.0f, 0.0f, 0.0f)));
+        }
+
+        for (unsigned int i = 0; i < 10; i += 2)
+            hierarchy._remove(entities[i]);
+
+        CHECK_EQUAL(5, hierarchy.getNbEntities());
+        CHECK(!hierarchy.contains(entities[0]));
+        CHECK(hierarchy.contains(entities[1]));
+
+        // Nothing happens with an entity not in the hierarchy
+        hierarchy._remove(entities[0]);
+        CHECK_EQUAL(5, hierarchy.getNbEntities());
+
+        CHECK(Vector3(9.5f, -0.5f, -0.5f).positionEquals(hierarchy.getBounds().min));
+        CHECK(Vector3(90.5f, 0.5f, 0.5f).positionEquals(hierarchy.getBounds().max));
+
+        for (unsigned int i = 1; i < 10; i += 2)
+            hierarchy._remove(entities[i]);
+
+        CHECK_EQUAL(0, hierarchy.getNbEntities());
+        CHECK_EQUAL(0, hierarchy.getDepth());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RayCast)
+    {
+        BoundsHierarchy hierarchy;
+
+        Entity* entities[20];
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            entities[i] = createEntity(pScene, i);
+            hierarchy._update(entities[i], unitBox(Vector3(i * 10.0f, (i % 2) * 10.0f, 0.0f)));
+        }
+
+        // Hits the even entities, sorted by distance
+        BoundsHierarchy::tRayHit hits[20];
+        unsigned int nbHits = hierarchy.castRay(Vector3(-10.0f, 0.0f, 0.0f), Vector3::UNIT_X,
+                                                1000.0f, hits, 20);
+
+        CHECK_EQUAL(10, nbHits);
+        for (unsigned int i = 0; i < nbHits; ++i)
+        {
+            CHECK_EQUAL(entities[i * 2], hits[i].pEntity);
+            CHECK_CLOSE(9.5f + i * 20.0f, hits[i].distance, 1e-4f);
+        }
+
+        // Only the nearest hits are kept
+        nbHits = hierarchy.castRay(Vector3(-10.0f, 0.0f, 0.0f), Vector3::UNIT_X, 1000.0f, hits, 2);
+
+        CHECK_EQUAL(2, nbHits);
+        CHECK_EQUAL(entities[0], hits[0].pEntity);
+        CHECK_EQUAL(entities[2], hits[1].pEntity);
+
+        // Limited length
+        nbHits = hierarchy.castRay(Vector3(-10.0f, 0.0f, 0.0f), Vector3::UNIT_X, 35.0f, hits, 20);
+        CHECK_EQUAL(2, nbHits);
+
+        // Starting inside an entity
+        nbHits = hierarchy.castRay(Vector3(50.0f, 10.0f, 0.0f), Vector3::NEGATIVE_UNIT_Y, 100.0f, hits, 20);
+
+        CHECK_EQUAL(1, nbHits);
+        CHECK_EQUAL(entities[5], hits[0].pEntity);
+        CHECK_EQUAL(0.0f, hits[0].distance);
+
+        // Missing everything
+        nbHits = hierarchy.castRay(Vector3(-10.0f, 5.0f, 0.0f), Vector3::UNIT_X, 1000.0f, hits, 20);
+        CHECK_EQUAL(0, nbHits);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, FrustumQuery)
+    {
+        BoundsHierarchy hierarchy;
+
+        Entity* entities[20];
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            entities[i] = createEntity(pScene, i);
+            hierarchy._update(entities[i], unitBox(Vector3(i * 10.0f, 0.0f, 0.0f)));
+        }
+
+        Entity* pFound[20];
+        unsigned int nbFound = hierarchy.getEntitiesInFrustum(
+                                    boxFrustum(Vector3(15.0f, -1.0f, -1.0f), Vector3(50.2f, 1.0f, 1.0f)),
+                                    pFound, 20);
+
+        CHECK_EQUAL(4, nbFound);
+        for (unsigned int i = 2; i <= 5; ++i)
+            CHECK(std::find(pFound, pFound + nbFound, entities[i]) != pFound + nbFound);
+
+        // The number of entities in the frustum is returned even if the buffer is too small
+        nbFound = hierarchy.getEntitiesInFrustum(
+                        boxFrustum(Vector3(-100.0f, -1.0f, -1.0f), Vector3(1000.0f, 1.0f, 1.0f)),
+                        pFound, 5);
+
+        CHECK_EQUAL(20, nbFound);
+    }
+}
@@ -1,12 +1,16 @@
 #include <UnitTest++.h>
 #include <Athena-Entities/ComponentsList.h>
 #include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/ComponentsManager.h>
 #include "../environments/EntitiesTestEnvironment.h"
+#include <sstream>
 
 
 using namespace Athena;
 using namespace Athena::Entities;
 using namespace Athena::Utils;
+using namespace std;
 
 
 SUITE(ComponentsListTests)
@@ -72,4 +76,77 @@ SUITE(ComponentsListTests)
 
         pScene->destroy(pEntity);
     }
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RetrieveComponents)
+    {
+        ComponentsList* pList = new ComponentsList();
+
+        Component* components[20];
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            ostringstream str;
+            str << "Component" << i;
+            components[i] = new Component(str.str(), pList);
+        }
+
+        CHECK_EQUAL(20, pList->getNbComponents());
+
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            CHECK(components[i] == pList->getComponent(i));
+            CHECK(components[i] == pList->getComponent(tComponentID(COMP_OTHER, components[i]->getName())));
+        }
+
+        CHECK(!pList->getComponent(tComponentID(COMP_OTHER, "Unknown")));
+        CHECK(!pList->getComponent(tComponentID(COMP_VISUAL, "Component0")));
+
+        delete pList;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RemoveComponent)
+    {
+        ComponentsList* pList = new ComponentsList();
+
+        Component* pComponent1 = new Component("Component1", pList);
+        Component* pComponent2 = new Component("Component2", pList);
+        Component* pComponent3 = new Component("Component3", pList);
+
+        pComponentsManager->destroy(pComponent2);
+
+        CHECK_EQUAL(2, pList->getNbComponents());
+        CHECK(!pList->getComponent(tComponentID(COMP_OTHER, "Component2")));
+        CHECK(pComponent1 == pList->getComponent(tComponentID(COMP_OTHER, "Component1")));
+        CHECK(pComponent3 == pList->getComponent(tComponentID(COMP_OTHER, "Component3")));
+
+        // The order is preserved
+        unsigned int uiIndex = 1;
+        CHECK(pComponent3 == pList->getComponent(uiIndex));
+
+        pComponent2 = new Component("Component2", pList);
+        CHECK(pComponent2 == pList->getComponent(tComponentID(COMP_OTHER, "Component2")));
+
+        delete pList;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RetrieveComponentsWithTheSameName)
+    {
+        ComponentsList* pList = new ComponentsList();
+
+        Entity* pEntity = pScene->create("test");
+        pList->_setEntity(pEntity);
+
+        Component* pTransforms = Transforms::create("Shared", pList);
+        Component* pComponent = new Component("Shared", pList);
+
+        CHECK(pTransforms == pList->getComponent(tComponentID(COMP_TRANSFORMS, "Shared")));
+        CHECK(pComponent == pList->getComponent(tComponentID(COMP_OTHER, "Shared")));
+        CHECK(pComponent == pList->getComponent(tComponentID(COMP_OTHER, "test", "Shared")));
+        CHECK(!pList->getComponent(tComponentID(COMP_OTHER, "other", "Shared")));
+
+        delete pList;
+
+        pScene->destroy(pEntity);
+    }
 }
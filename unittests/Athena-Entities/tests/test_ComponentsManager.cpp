@@ -1,12 +1,81 @@
 #include <UnitTest++.h>
 #include <Athena-Entities/ComponentsManager.h>
 #include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/Transforms.h>
 #include "../environments/EntitiesTestEnvironment.h"
 
 
 using namespace Athena::Entities;
 
 
+class PooledComponent: public Component
+{
+public:
+    PooledComponent(const std::string& strName, ComponentsList* pList)
+    : Component(strName, pList), value(42)
+    {
+        m_typeID = TYPE_ID;
+    }
+
+    static PooledComponent* create(const std::string& strName, ComponentsList* pList)
+    {
+        return new PooledComponent(strName, pList);
+    }
+
+    virtual const std::string getType() const { return TYPE; }
+
+    static const std::string TYPE;
+    static const tTypeID TYPE_ID;
+
+    double value;
+};
+
+const std::string PooledComponent::TYPE = "PooledComponent";
+const Component::tTypeID PooledComponent::TYPE_ID = Component::_newTypeID(&Component::TYPE_ID);
+
+
+class UnidentifiedComponent: public PooledComponent
+{
+public:
+    UnidentifiedComponent(const std::string& strName, ComponentsList* pList)
+    : PooledComponent(strName, pList)
+    {
+    }
+
+    static UnidentifiedComponent* create(const std::string& strName, ComponentsList* pList)
+    {
+        return new UnidentifiedComponent(strName, pList);
+    }
+
+    virtual const std::string getType() const { return TYPE; }
+
+    static const std::string TYPE;
+};
+
+const std::string UnidentifiedComponent::TYPE = "UnidentifiedComponent";
+
+
+class DerivedTransforms: public Transforms
+{
+public:
+    DerivedTransforms(const std::string& strName, ComponentsList* pList)
+    : Transforms(strName, pList)
+    {
+    }
+
+    static DerivedTransforms* create(const std::string& strName, ComponentsList* pList)
+    {
+        return new DerivedTransforms(strName, pList);
+    }
+
+    virtual const std::string getType() const { return TYPE; }
+
+    static const std::string TYPE;
+};
+
+const std::string DerivedTransforms::TYPE = "DerivedTransforms";
+
+
 TEST(ComponentsManager_Singleton)
 {
     CHECK(!ComponentsManager::getSingletonPtr());
@@ -48,4 +117,228 @@ SUITE(ComponentsManagerTests)
 
         delete pList;
     }
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TypeWithoutPool)
+    {
+        CHECK(!pComponentsManager->getPool(Component::TYPE));
+        CHECK(!pComponentsManager->getPool("Unknown"));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, PooledComponentCreation)
+    {
+        pComponentsManager->registerType<PooledComponent>(4);
+
+        ComponentsPool* pPool = pComponentsManager->getPool(PooledComponent::TYPE);
+        CHECK(pPool);
+
+        ComponentsList* pList = new ComponentsList();
+
+        Component* pComponent = pComponentsManager->create(PooledComponent::TYPE, "test", pList);
+
+        CHECK(pComponent);
+        CHECK(pComponent->getType() == PooledComponent::TYPE);
+        CHECK_EQUAL(42.0, component_cast<PooledComponent>(pComponent)->value);
+        CHECK(pComponent == pList->getComponent(0));
+
+        CHECK_EQUAL(1, pPool->getNbObjects());
+        CHECK_EQUAL(4, pPool->getCapacity());
+        CHECK_EQUAL(1, pPool->getHighWaterMark());
+
+        delete pList;
+
+        CHECK_EQUAL(0, pPool->getNbObjects());
+        CHECK_EQUAL(1, pPool->getHighWaterMark());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, PooledComponentsReuseTheMemory)
+    {
+        pComponentsManager->registerType<PooledComponent>(4);
+
+        ComponentsPool* pPool = pComponentsManager->getPool(PooledComponent::TYPE);
+        ComponentsList* pList = new ComponentsList();
+
+        Component* components[6];
+        for (unsigned int i = 0; i < 6; ++i)
+            components[i] = pComponentsManager->create(PooledComponent::TYPE, std::string(1, 'a' + i), pList);
+
+        CHECK_EQUAL(6, pPool->getNbObjects());
+        CHECK_EQUAL(8, pPool->getCapacity());
+
+        Component* pDestroyed = components[2];
+        pComponentsManager->destroy(pDestroyed);
+
+        CHECK_EQUAL(5, pPool->getNbObjects());
+
+        Component* pComponent = pComponentsManager->create(PooledComponent::TYPE, "other", pList);
+        CHECK(pComponent == pDestroyed);
+
+        CHECK_EQUAL(6, pPool->getNbObjects());
+        CHECK_EQUAL(8, pPool->getCapacity());
+        CHECK_EQUAL(6, pPool->getHighWaterMark());
+
+        delete pList;
+
+        CHECK_EQUAL(0, pPool->getNbObjects());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, PooledTypeWithComponentsCreatedOnTheHeap)
+    {
+        pComponentsManager->registerType<PooledComponent>(4);
+
+        ComponentsList* pList = new ComponentsList();
+
+        Component* pComponent = new PooledComponent("test", pList);
+
+        CHECK_EQUAL(0, pComponentsManager->getPool(PooledComponent::TYPE)->getNbObjects());
+
+        pComponentsManager->destroy(pComponent);
+
+        CHECK_EQUAL(0, pList->getNbComponents());
+
+        delete pList;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ComponentCast)
+    {
+        pComponentsManager->registerType<PooledComponent>();
+
+        ComponentsList* pList = new ComponentsList();
+
+        Component* pComponent = pComponentsManager->create(Component::TYPE, "base", pList);
+        Component* pTransforms = pComponentsManager->create(Transforms::TYPE, "transforms", pList);
+        Component* pPooled = pComponentsManager->create(PooledComponent::TYPE, "pooled", pList);
+
+        CHECK_EQUAL(Component::TYPE_ID, pComponent->getTypeID());
+        CHECK_EQUAL(Transforms::TYPE_ID, pTransforms->getTypeID());
+        CHECK_EQUAL(PooledComponent::TYPE_ID, pPooled->getTypeID());
+        CHECK(Component::TYPE_ID != Transforms::TYPE_ID);
+        CHECK(Component::TYPE_ID != PooledComponent::TYPE_ID);
+
+        CHECK_EQUAL(pTransforms, component_cast<Transforms>(pTransforms));
+        CHECK_EQUAL(pTransforms, Transforms::cast(pTransforms));
+        CHECK(!component_cast<Transforms>(pComponent));
+        CHECK(!component_cast<Transforms>(pPooled));
+        CHECK(!component_cast<Transforms>((Component*) 0));
+        CHECK_EQUAL(pPooled, component_cast<PooledComponent>(pPooled));
+
+        delete pList;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TypeWithoutItsOwnTypeID)
+    {
+        pComponentsManager->registerType<PooledComponent>();
+        pComponentsManager->registerType<UnidentifiedComponent>(4);
+
+        Component::tTypeID typeID = pComponentsManager->getTypeID(UnidentifiedComponent::TYPE);
+        CHECK(typeID != Component::INVALID_TYPE_ID);
+        CHECK(typeID != PooledComponent::TYPE_ID);
+        CHECK_EQUAL(typeID, tComponentTypeID<UnidentifiedComponent>::value);
+        CHECK_EQUAL(PooledComponent::TYPE_ID, tComponentTypeID<PooledComponent>::value);
+
+        ComponentsList list;
+
+        Component* pPooled = pComponentsManager->create(PooledComponent::TYPE, "pooled", &list);
+        Component* pComponent = pComponentsManager->create(UnidentifiedComponent::TYPE, "test", &list);
+        Component* pComponent2 = pComponentsManager->create(typeID, "test2", &list);
+
+        CHECK(pComponent);
+        CHECK_EQUAL(UnidentifiedComponent::TYPE, pComponent->getType());
+        CHECK_EQUAL(typeID, pComponent->getTypeID());
+        CHECK_EQUAL(UnidentifiedComponent::TYPE, pComponent2->getType());
+        CHECK_EQUAL(typeID, pComponent2->getTypeID());
+
+        CHECK_EQUAL(pComponent, component_cast<UnidentifiedComponent>(pComponent));
+        CHECK_EQUAL(pComponent, component_cast<PooledComponent>(pComponent));
+        CHECK(!component_cast<UnidentifiedComponent>(pPooled));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SubclassOfTransforms)
+    {
+        pComponentsManager->registerType<DerivedTransforms>();
+
+        ComponentsList list;
+
+        Component* pComponent = pComponentsManager->create(DerivedTransforms::TYPE, "test", &list);
+        Transforms* pTransforms = new Transforms("transforms", &list);
+
+        CHECK(pComponent);
+        CHECK(pComponent->getTypeID() != Transforms::TYPE_ID);
+        CHECK(pComponent == Transforms::cast(pComponent));
+        CHECK(pComponent == component_cast<DerivedTransforms>(pComponent));
+        CHECK(!component_cast<DerivedTransforms>(pTransforms));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ParentTypesOfAComponent)
+    {
+        pComponentsManager->registerType<PooledComponent>();
+        pComponentsManager->registerType<UnidentifiedComponent>();
+
+        bool bUnknown = false;
+        CHECK(Component::_isDerivedType(Transforms::TYPE_ID, Component::TYPE_ID, bUnknown));
+        CHECK(!bUnknown);
+        CHECK(!Component::_isDerivedType(Component::TYPE_ID, PooledComponent::TYPE_ID, bUnknown));
+        CHECK(!bUnknown);
+
+        Component::tTypeID typeID = tComponentTypeID<UnidentifiedComponent>::value;
+        CHECK(Component::_isDerivedType(typeID, PooledComponent::TYPE_ID, bUnknown));
+        CHECK(Component::_isDerivedType(typeID, Component::TYPE_ID, bUnknown));
+        CHECK(!bUnknown);
+
+        // The components created outside of the manager keep the identifier of the
+        // parent class
+        CHECK(!Component::_isDerivedType(PooledComponent::TYPE_ID, typeID, bUnknown));
+        CHECK(bUnknown);
+
+        ComponentsList list;
+        UnidentifiedComponent* pComponent = new UnidentifiedComponent("test", &list);
+        PooledComponent* pPooled = new PooledComponent("pooled", &list);
+
+        CHECK_EQUAL(PooledComponent::TYPE_ID, pComponent->getTypeID());
+        CHECK_EQUAL(pComponent, component_cast<UnidentifiedComponent>(pComponent));
+        CHECK(!component_cast<UnidentifiedComponent>(pPooled));
+        CHECK(!component_cast<Transforms>(pComponent));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TypeIDRetrieval)
+    {
+        CHECK_EQUAL(Component::TYPE_ID, pComponentsManager->getTypeID(Component::TYPE));
+        CHECK_EQUAL(Transforms::TYPE_ID, pComponentsManager->getTypeID(Transforms::TYPE));
+        CHECK_EQUAL(Component::INVALID_TYPE_ID, pComponentsManager->getTypeID("Unknown"));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ComponentCreationWithTypeID)
+    {
+        ComponentsList list;
+
+        Component* pComponent = pComponentsManager->create(Transforms::TYPE_ID, "test", &list);
+
+        CHECK(pComponent);
+        CHECK_EQUAL(Transforms::TYPE, pComponent->getType());
+        CHECK(pComponent == list.getComponent(0));
+
+        CHECK(!pComponentsManager->create(Component::INVALID_TYPE_ID, "test2", &list));
+        CHECK(!pComponentsManager->create(PooledComponent::TYPE_ID, "test2", &list));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, PooledComponentCreationWithTypeID)
+    {
+        pComponentsManager->registerType<PooledComponent>(4);
+
+        ComponentsList list;
+
+        Component* pComponent = pComponentsManager->create(PooledComponent::TYPE_ID, "test", &list);
+
+        CHECK(component_cast<PooledComponent>(pComponent));
+        CHECK_EQUAL(1, pComponentsManager->getPool(PooledComponent::TYPE)->getNbObjects());
+    }
 }
@@ -0,0 +1,89 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/ComponentsPool.h>
+
+
+using namespace Athena::Entities;
+
+
+SUITE(ComponentsPoolTests)
+{
+    TEST(Creation)
+    {
+        ComponentsPool pool(40, 8, 16);
+
+        CHECK_EQUAL(0, pool.getNbObjects());
+        CHECK_EQUAL(0, pool.getCapacity());
+        CHECK_EQUAL(0, pool.getHighWaterMark());
+        CHECK_EQUAL(40, pool.getBlockSize());
+    }
+
+
+    TEST(BlockSizeIsAligned)
+    {
+        ComponentsPool pool1(2, 1, 16);
+        CHECK_EQUAL(sizeof(void*), pool1.getBlockSize());
+
+        ComponentsPool pool2(20, 16, 16);
+        CHECK_EQUAL(32, pool2.getBlockSize());
+    }
+
+
+    TEST(Allocation)
+    {
+        ComponentsPool pool(32, 8, 2);
+
+        void* pObject1 = pool.allocate();
+        void* pObject2 = pool.allocate();
+        void* pObject3 = pool.allocate();
+
+        CHECK(pObject1 && pObject2 && pObject3);
+        CHECK(pObject1 != pObject2);
+        CHECK(pObject2 != pObject3);
+        CHECK_EQUAL(32, (char*) pObject2 - (char*) pObject1);
+        CHECK_EQUAL(0, ((size_t) pObject3) % 8);
+
+        CHECK_EQUAL(3, pool.getNbObjects());
+        CHECK_EQUAL(4, pool.getCapacity());
+        CHECK_EQUAL(3, pool.getHighWaterMark());
+
+        pool.release(pObject1);
+        pool.release(pObject2);
+        pool.release(pObject3);
+    }
+
+
+    TEST(Release)
+    {
+        ComponentsPool pool(32, 8, 4);
+
+        void* pObject1 = pool.allocate();
+        void* pObject2 = pool.allocate();
+
+        pool.release(pObject1);
+
+        CHECK_EQUAL(1, pool.getNbObjects());
+        CHECK_EQUAL(2, pool.getHighWaterMark());
+
+        // The last released block is reused first
+        CHECK(pObject1 == pool.allocate());
+        CHECK_EQUAL(4, pool.getCapacity());
+
+        pool.release(pObject1);
+        pool.release(pObject2);
+
+        CHECK_EQUAL(0, pool.getNbObjects());
+    }
+
+
+    TEST(Reserve)
+    {
+        ComponentsPool pool(32, 8, 4);
+
+        pool.reserve(10);
+        CHECK_EQUAL(12, pool.getCapacity());
+
+        pool.reserve(5);
+        CHECK_EQUAL(12, pool.getCapacity());
+        CHECK_EQUAL(0, pool.getNbObjects());
+    }
+}
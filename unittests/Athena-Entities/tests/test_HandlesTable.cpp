@@ -0,0 +1,81 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/HandlesTable.h>
+
+
+using namespace Athena::Entities;
+
+
+SUITE(HandlesTableTests)
+{
+    TEST(InvalidHandle)
+    {
+        HandlesTable table;
+        tHandle handle;
+
+        CHECK(!handle.isValid());
+        CHECK(!table.get(handle));
+        CHECK_EQUAL(0, table.getNbObjects());
+    }
+
+
+    TEST(Allocation)
+    {
+        HandlesTable table;
+        int object1, object2;
+
+        tHandle handle1 = table.allocate(&object1);
+        tHandle handle2 = table.allocate(&object2);
+
+        CHECK(handle1.isValid());
+        CHECK(handle2.isValid());
+        CHECK(handle1 != handle2);
+        CHECK_EQUAL(2, table.getNbObjects());
+
+        CHECK_EQUAL((void*) &object1, table.get(handle1));
+        CHECK_EQUAL((void*) &object2, table.get(handle2));
+    }
+
+
+    TEST(Release)
+    {
+        HandlesTable table;
+        int object1, object2;
+
+        tHandle handle1 = table.allocate(&object1);
+        tHandle handle2 = table.allocate(&object2);
+
+        table.release(handle1);
+
+        CHECK(!table.get(handle1));
+        CHECK_EQUAL((void*) &object2, table.get(handle2));
+        CHECK_EQUAL(1, table.getNbObjects());
+    }
+
+
+    TEST(StaleHandleAfterReuse)
+    {
+        HandlesTable table;
+        int object1, object2;
+
+        tHandle handle1 = table.allocate(&object1);
+        table.release(handle1);
+
+        tHandle handle2 = table.allocate(&object2);
+
+        CHECK_EQUAL(handle1.uiIndex, handle2.uiIndex);
+        CHECK(handle1 != handle2);
+        CHECK(!table.get(handle1));
+        CHECK_EQUAL((void*) &object2, table.get(handle2));
+    }
+
+
+    TEST(HandleOutOfTheTable)
+    {
+        HandlesTable table;
+        int object;
+
+        table.allocate(&object);
+
+        CHECK(!table.get(tHandle(10, 1)));
+    }
+}
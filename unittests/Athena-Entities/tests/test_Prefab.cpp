@@ -0,0 +1,205 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/Prefab.h>
+#include <Athena-Entities/ScenesManager.h>
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/Serialization.h>
+#include "../environments/EntitiesTestEnvironment.h"
+
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+
+
+// Creates 'tank' (at (1, 2, 3)) with a child 'turret' (at (0, 1, 0)), which has a
+// 'Sensor' component linked to the Transforms of 'tank'
+static Entity* createTank(Scene* pScene)
+{
+    Entity* pTank = pScene->create("tank");
+    pTank->getTransforms()->setPosition(1.0f, 2.0f, 3.0f);
+
+    Entity* pTurret = pScene->create("turret", pTank);
+    pTurret->getTransforms()->setPosition(0.0f, 1.0f, 0.0f);
+
+    Component* pSensor = new Component("Sensor", pTurret->getComponentsList());
+    pSensor->setTransforms(pTank->getTransforms());
+
+    return pTank;
+}
+
+
+SUITE(PrefabTests)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, Compilation)
+    {
+        Prefab prefab;
+        CHECK(prefab.isEmpty());
+
+        Entity* pTank = createTank(pScene);
+
+        prefab.compile(pTank);
+        CHECK(!prefab.isEmpty());
+        CHECK_EQUAL(2, prefab.getNbEntities());
+        CHECK_EQUAL(3, prefab.getNbComponents());
+
+        prefab.clear();
+        CHECK(prefab.isEmpty());
+        CHECK_EQUAL(0, prefab.getNbComponents());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, Instantiation)
+    {
+        Entity* pTank = createTank(pScene);
+        Prefab prefab(pTank);
+
+        Entity* pInstance = prefab.instantiate("tank1", pScene);
+
+        CHECK(pInstance);
+        CHECK(pInstance != pTank);
+        CHECK_EQUAL("tank1", pInstance->getName());
+        CHECK(!pInstance->getParent());
+        CHECK_EQUAL(1, pInstance->getNbComponents());
+        CHECK_EQUAL(1, pInstance->getNbChildren());
+
+        Entity* pTurret = pInstance->getChild(0);
+        CHECK_EQUAL("tank1.turret", pTurret->getName());
+        CHECK_EQUAL(pTurret, pScene->getEntity("tank1.turret"));
+        CHECK_EQUAL(2, pTurret->getNbComponents());
+        CHECK_EQUAL(0, pTurret->getNbChildren());
+
+        CHECK(pInstance->getTransforms()->getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+        CHECK(pTurret->getTransforms()->getPosition() == Vector3(0.0f, 1.0f, 0.0f));
+        CHECK(pTurret->getTransforms()->getWorldPosition() == Vector3(1.0f, 3.0f, 3.0f));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, LinksAreRemapped)
+    {
+        Entity* pTank = createTank(pScene);
+        Prefab prefab(pTank);
+
+        Entity* pInstance = prefab.instantiate("tank1", pScene);
+        Entity* pTurret = pInstance->getChild(0);
+
+        CHECK_EQUAL(pInstance->getTransforms(), pTurret->getTransforms()->getTransforms());
+
+        Component* pSensor = pTurret->getComponent(1);
+        CHECK_EQUAL("Sensor", pSensor->getName());
+        CHECK_EQUAL(pInstance->getTransforms(), pSensor->getTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, LinksOutsideOfThePrefabAreReset)
+    {
+        Entity* pOther = pScene->create("other");
+
+        Entity* pTank = createTank(pScene);
+        pTank->getChild(0)->getComponent(1)->setTransforms(pOther->getTransforms());
+
+        Prefab prefab(pTank->getChild(0));
+
+        Entity* pInstance = prefab.instantiate("turret1", pScene);
+
+        CHECK(!pInstance->getTransforms()->getTransforms());
+        CHECK_EQUAL(pInstance->getTransforms(), pInstance->getComponent(1)->getTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SeveralInstances)
+    {
+        Entity* pTank = createTank(pScene);
+        Prefab prefab(pTank);
+
+        Entity* pInstance1 = prefab.instantiate("tank1", pScene);
+        Entity* pInstance2 = prefab.instantiate("tank2", pScene);
+
+        CHECK(pInstance1 != pInstance2);
+        CHECK_EQUAL(pInstance2->getChild(0), pScene->getEntity("tank2.turret"));
+
+        pInstance1->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+
+        CHECK(pInstance2->getTransforms()->getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+        CHECK_EQUAL(pInstance2->getTransforms(),
+                    pInstance2->getChild(0)->getComponent(1)->getTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SourceModifiedAfterCompilation)
+    {
+        Entity* pTank = createTank(pScene);
+        Prefab prefab(pTank);
+
+        pTank->getTransforms()->setPosition(5.0f, 5.0f, 5.0f);
+        pScene->destroy(pTank);
+
+        Entity* pInstance = prefab.instantiate("tank1", pScene);
+
+        CHECK(pInstance->getTransforms()->getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+        CHECK_EQUAL(1, pInstance->getNbChildren());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, BoundsAndState)
+    {
+        Entity* pTank = createTank(pScene);
+        pTank->setBounds(tBounds(Vector3(-1.0f), Vector3(1.0f)));
+        pTank->getChild(0)->enable(false);
+
+        Prefab prefab(pTank);
+
+        Entity* pInstance = prefab.instantiate("tank1", pScene);
+
+        CHECK(pInstance->hasBounds());
+        CHECK(pInstance->getBounds() == tBounds(Vector3(-1.0f), Vector3(1.0f)));
+        CHECK(pInstance->isEnabled());
+
+        CHECK(!pInstance->getChild(0)->hasBounds());
+        CHECK(!pInstance->getChild(0)->isEnabled());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, InstantiationWithParent)
+    {
+        Entity* pParent = pScene->create("parent");
+        pParent->getTransforms()->setPosition(0.0f, 0.0f, 10.0f);
+
+        Entity* pTank = createTank(pScene);
+        Prefab prefab(pTank);
+
+        Entity* pInstance = prefab.instantiate("tank1", pScene, pParent);
+
+        CHECK_EQUAL(pParent, pInstance->getParent());
+        CHECK_EQUAL(pParent->getTransforms(), pInstance->getTransforms()->getTransforms());
+        CHECK(pInstance->getTransforms()->getWorldPosition() == Vector3(1.0f, 2.0f, 13.0f));
+    }
+}
+
+
+SUITE(PrefabJSONDeserialization)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, DeserializationFromString)
+    {
+        std::string reference = readFile("one_child.entity");
+
+        Prefab prefab;
+        CHECK(fromJSON(reference, &prefab));
+        CHECK_EQUAL(2, prefab.getNbEntities());
+
+        // The temporary entities are destroyed
+        CHECK(!pScene->getEntity("parent"));
+
+        Entity* pInstance = prefab.instantiate("parent1", pScene);
+        CHECK_EQUAL(1, pInstance->getNbChildren());
+        CHECK_EQUAL("parent1.child", pInstance->getChild(0)->getName());
+        CHECK_EQUAL(pInstance->getTransforms(), pInstance->getChild(0)->getTransforms()->getTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, InvalidJSON)
+    {
+        Prefab prefab;
+        CHECK(!fromJSON("{ \"name\": \"test\" }", &prefab));
+        CHECK(prefab.isEmpty());
+    }
+}
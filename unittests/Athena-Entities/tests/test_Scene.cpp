@@ -1,12 +1,16 @@
 #include <UnitTest++.h>
 #include <Athena-Entities/ScenesManager.h>
 #include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
 #include <Athena-Entities/Serialization.h>
 #include <Athena-Core/Data/FileDataStream.h>
+#include <sstream>
+#include <algorithm>
 #include "../environments/EntitiesTestEnvironment.h"
 
 
 using namespace Athena::Entities;
+using namespace Athena::Math;
 using namespace Athena::Data;
 
 
@@ -60,6 +64,536 @@ SUITE(SceneTests)
     }
 
 
+    TEST_FIXTURE(EntitiesTestEnvironment, LastEntityTakesTheIndexOfADestroyedOne)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+        Entity* pEntity3 = pScene->create("test3");
+
+        pScene->destroy(pEntity1);
+
+        CHECK_EQUAL(2, pScene->getNbEntities());
+        CHECK_EQUAL(pEntity3, pScene->getEntity((unsigned int) 0));
+        CHECK_EQUAL(pEntity2, pScene->getEntity((unsigned int) 1));
+
+        CHECK(!pScene->getEntity("test1"));
+        CHECK_EQUAL(pEntity2, pScene->getEntity("test2"));
+        CHECK_EQUAL(pEntity3, pScene->getEntity("test3"));
+
+        pScene->destroy("test3");
+
+        CHECK_EQUAL(1, pScene->getNbEntities());
+        CHECK_EQUAL(pEntity2, pScene->getEntity((unsigned int) 0));
+        CHECK(!pScene->getEntity("test3"));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DestructionOfAnEntityOfAnotherScene)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pEntity = pScene->create("test");
+        pScene2->create("test");
+
+        pScene2->destroy(pEntity);
+
+        CHECK_EQUAL(1, pScene->getNbEntities());
+        CHECK_EQUAL(1, pScene2->getNbEntities());
+        CHECK_EQUAL(pEntity, pScene->getEntity("test"));
+
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DestroyedEntityIsReused)
+    {
+        Entity* pEntity = pScene->create("test");
+        new Transforms("T2", pEntity->getComponentsList());
+        pEntity->getTransforms()->setPosition(10.0f, 20.0f, 30.0f);
+        pEntity->enable(false);
+
+        pScene->destroy(pEntity);
+
+        CHECK_EQUAL(0, pScene->getNbEntities());
+        CHECK_EQUAL(1, pScene->getNbFreeEntities());
+        CHECK_EQUAL(0, pScene->getTransformsStore()->getNbTransforms());
+
+        Entity* pNewEntity = pScene->create("other");
+
+        CHECK_EQUAL(pEntity, pNewEntity);
+        CHECK_EQUAL(0, pScene->getNbFreeEntities());
+        CHECK_EQUAL(1, pScene->getTransformsStore()->getNbTransforms());
+        CHECK(!pScene->getEntity("test"));
+        CHECK_EQUAL(pNewEntity, pScene->getEntity("other"));
+
+        CHECK_EQUAL("other", pNewEntity->getName());
+        CHECK(pNewEntity->isEnabled());
+        CHECK_EQUAL(1, pNewEntity->getNbComponents());
+        CHECK_EQUAL("other", pNewEntity->getTransforms()->getID().strEntity);
+        CHECK_EQUAL(pScene->getTransformsStore(), pNewEntity->getTransforms()->getStore());
+        CHECK_EQUAL(Vector3::ZERO, pNewEntity->getTransforms()->getWorldPosition());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ChildrenOfADestroyedEntityAreReused)
+    {
+        Entity* pParent = pScene->create("parent");
+        pScene->create("child", pParent);
+
+        pScene->destroy(pParent);
+
+        CHECK_EQUAL(0, pScene->getNbEntities());
+        CHECK_EQUAL(2, pScene->getNbFreeEntities());
+
+        Entity* pNewParent = pScene->create("parent2");
+        Entity* pNewChild = pScene->create("child2", pNewParent);
+
+        CHECK_EQUAL(0, pScene->getNbFreeEntities());
+        CHECK_EQUAL(1, pNewParent->getNbChildren());
+        CHECK_EQUAL(pNewParent, pNewChild->getParent());
+        CHECK_EQUAL(0, pNewChild->getNbChildren());
+
+        pNewParent->getTransforms()->setPosition(1.0f, 2.0f, 3.0f);
+
+        CHECK_EQUAL(Vector3(1.0f, 2.0f, 3.0f), pNewChild->getTransforms()->getWorldPosition());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DestructionOfAHierarchy)
+    {
+        Entity* pRoot = pScene->create("root");
+        Entity* pParent = pScene->create("parent", pRoot);
+        Entity* pSibling = pScene->create("sibling", pRoot);
+
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            std::ostringstream str;
+            str << "child" << i;
+
+            Entity* pChild = pScene->create(str.str(), pParent);
+            pScene->create(str.str() + "_child", pChild);
+
+            Component* pComponent = Component::create("Comp", pChild->getComponentsList());
+            pComponent->setTransforms(pChild->getTransforms());
+        }
+
+        // A component of the scene, which must be notified
+        Component* pSceneComponent = Component::create("Comp", pScene->getComponentsList());
+        pSceneComponent->setTransforms(pScene->getEntity("child3")->getTransforms());
+
+        pScene->destroy(pParent);
+
+        CHECK_EQUAL(2, pScene->getNbEntities());
+        CHECK_EQUAL(21, pScene->getNbFreeEntities());
+        CHECK_EQUAL(1, pScene->getNbComponents(Component::TYPE));
+        CHECK(!pSceneComponent->getTransforms());
+
+        CHECK_EQUAL(1, pRoot->getNbChildren());
+        CHECK_EQUAL(pSibling, pRoot->getChild((unsigned int) 0));
+
+        pRoot->getTransforms()->setPosition(1.0f, 2.0f, 3.0f);
+
+        CHECK_EQUAL(Vector3(1.0f, 2.0f, 3.0f), pSibling->getTransforms()->getWorldPosition());
+
+        // The recycled entities are usable
+        Entity* pNewParent = pScene->create("parent", pRoot);
+        Entity* pNewChild = pScene->create("child", pNewParent);
+
+        CHECK_EQUAL(1, pNewParent->getNbComponents());
+        CHECK_EQUAL(0, pNewChild->getNbChildren());
+        CHECK_EQUAL(Vector3(1.0f, 2.0f, 3.0f), pNewChild->getTransforms()->getWorldPosition());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DestructionOfAllTheEntities)
+    {
+        Entity* pParent = pScene->create("parent");
+
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            std::ostringstream str;
+            str << "child" << i;
+
+            pScene->create(str.str(), pParent);
+        }
+
+        Component* pSceneComponent = Component::create("Comp", pScene->getComponentsList());
+        pSceneComponent->setTransforms(pParent->getTransforms());
+
+        pScene->destroyAll();
+
+        CHECK_EQUAL(0, pScene->getNbEntities());
+        CHECK_EQUAL(11, pScene->getNbFreeEntities());
+        CHECK_EQUAL(0, pScene->getNbComponents(Transforms::TYPE));
+        CHECK(!pSceneComponent->getTransforms());
+        CHECK_EQUAL(0, pScene->getTransformsStore()->getNbTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ReservedEntities)
+    {
+        unsigned int nbDefaultTransforms = TransformsStore::getDefault()->getNbTransforms();
+
+        pScene->reserveEntities(10);
+
+        CHECK_EQUAL(0, pScene->getNbEntities());
+        CHECK_EQUAL(10, pScene->getNbFreeEntities());
+        CHECK_EQUAL(0, pScene->getTransformsStore()->getNbTransforms());
+        CHECK_EQUAL(nbDefaultTransforms, TransformsStore::getDefault()->getNbTransforms());
+
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            std::ostringstream str;
+            str << "entity" << i;
+
+            Entity* pEntity = pScene->create(str.str());
+            CHECK_EQUAL(pScene->getTransformsStore(), pEntity->getTransforms()->getStore());
+        }
+
+        CHECK_EQUAL(10, pScene->getNbEntities());
+        CHECK_EQUAL(0, pScene->getNbFreeEntities());
+        CHECK_EQUAL(10, pScene->getTransformsStore()->getNbTransforms());
+
+        // The recycled entities give the slots of their transforms back to the store of
+        // the scene
+        pScene->destroyAll();
+
+        CHECK_EQUAL(0, pScene->getTransformsStore()->getNbTransforms());
+        CHECK_EQUAL(10, pScene->getTransformsStore()->getNbSlots());
+        CHECK_EQUAL(nbDefaultTransforms, TransformsStore::getDefault()->getNbTransforms());
+
+        Entity* pEntity = pScene->create("reused");
+        CHECK_EQUAL(10, pScene->getTransformsStore()->getNbSlots());
+        CHECK(pEntity->getTransforms()->getPosition() == Vector3::ZERO);
+    }
+
+
+    struct PositionsSum
+    {
+        PositionsSum() : sum(Vector3::ZERO), nbTransforms(0) {}
+
+        void operator()(Transforms* pTransforms)
+        {
+            sum += pTransforms->getPosition();
+            ++nbTransforms;
+        }
+
+        Vector3         sum;
+        unsigned int    nbTransforms;
+    };
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ComponentsByType)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+        Component::create("Comp", pEntity1->getComponentsList());
+        Component::create("Comp", pScene->getComponentsList());
+
+        pEntity1->getTransforms()->setPosition(1.0f, 2.0f, 3.0f);
+        pEntity2->getTransforms()->setPosition(10.0f, 20.0f, 30.0f);
+
+        CHECK_EQUAL(2, pScene->getNbComponents(Transforms::TYPE));
+        CHECK_EQUAL(2, pScene->getNbComponents(Component::TYPE));
+        CHECK_EQUAL(0, pScene->getNbComponents("Unknown"));
+
+        Component::tComponentsIterator iter = pScene->getComponentsIterator(Transforms::TYPE);
+        CHECK_EQUAL(pEntity1->getTransforms(), iter.getNext());
+        CHECK_EQUAL(pEntity2->getTransforms(), iter.getNext());
+        CHECK(!iter.hasMoreElements());
+
+        PositionsSum result = pScene->forEachComponent<Transforms>(PositionsSum());
+
+        CHECK_EQUAL(2, result.nbTransforms);
+        CHECK_EQUAL(Vector3(11.0f, 22.0f, 33.0f), result.sum);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ComponentsByTypeAfterDestruction)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+        Component::create("Comp", pEntity1->getComponentsList());
+
+        CHECK_EQUAL(2, pScene->getNbComponents(Transforms::TYPE));
+        CHECK_EQUAL(1, pScene->getNbComponents(Component::TYPE));
+
+        pScene->destroy(pEntity1);
+
+        CHECK_EQUAL(1, pScene->getNbComponents(Transforms::TYPE));
+        CHECK_EQUAL(0, pScene->getNbComponents(Component::TYPE));
+        CHECK_EQUAL(pEntity2->getTransforms(),
+                    pScene->getComponentsIterator(Transforms::TYPE).getNext());
+
+        pScene->create("test3");
+
+        CHECK_EQUAL(2, pScene->getNbComponents(Transforms::TYPE));
+
+        pScene->destroyAll();
+
+        CHECK_EQUAL(0, pScene->getNbComponents(Transforms::TYPE));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ComponentsByTypeAfterTransfer)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pEntity = pScene->create("test");
+        Component::create("Comp", pEntity->getComponentsList());
+
+        pScene2->transfer(pEntity);
+
+        CHECK_EQUAL(0, pScene->getNbComponents(Transforms::TYPE));
+        CHECK_EQUAL(0, pScene->getNbComponents(Component::TYPE));
+        CHECK_EQUAL(1, pScene2->getNbComponents(Transforms::TYPE));
+        CHECK_EQUAL(1, pScene2->getNbComponents(Component::TYPE));
+
+        pScene2->destroy(pEntity);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, EntityRetrievalByHandle)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+
+        CHECK(pEntity1->getHandle().isValid());
+        CHECK(pEntity1->getHandle() != pEntity2->getHandle());
+        CHECK_EQUAL(pEntity1, pScene->getEntity(pEntity1->getHandle()));
+        CHECK_EQUAL(pEntity2, pScene->getEntity(pEntity2->getHandle()));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, StaleEntityHandle)
+    {
+        Entity* pEntity = pScene->create("test");
+        tHandle handle = pEntity->getHandle();
+
+        pScene->destroy(pEntity);
+
+        CHECK(!pScene->getEntity(handle));
+
+        // The recycled entity gets a new handle
+        Entity* pNewEntity = pScene->create("other");
+
+        CHECK_EQUAL(pEntity, pNewEntity);
+        CHECK(!pScene->getEntity(handle));
+        CHECK_EQUAL(pNewEntity, pScene->getEntity(pNewEntity->getHandle()));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ComponentRetrievalByHandle)
+    {
+        Entity* pEntity = pScene->create("test");
+        Component* pComponent = Component::create("Comp", pEntity->getComponentsList());
+        Component* pSceneComponent = Component::create("Comp", pScene->getComponentsList());
+
+        CHECK_EQUAL(pComponent, pScene->getComponent(pComponent->getHandle()));
+        CHECK_EQUAL(pSceneComponent, pScene->getComponent(pSceneComponent->getHandle()));
+        CHECK_EQUAL(pEntity->getTransforms(),
+                    pScene->getComponent(pEntity->getTransforms()->getHandle()));
+
+        tHandle handle = pComponent->getHandle();
+        tHandle transformsHandle = pEntity->getTransforms()->getHandle();
+
+        pScene->destroy(pEntity);
+
+        CHECK(!pScene->getComponent(handle));
+        CHECK(!pScene->getComponent(transformsHandle));
+        CHECK_EQUAL(pSceneComponent, pScene->getComponent(pSceneComponent->getHandle()));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, HandlesAfterTransfer)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pEntity = pScene->create("test");
+        tHandle handle = pEntity->getHandle();
+        tHandle transformsHandle = pEntity->getTransforms()->getHandle();
+
+        pScene2->transfer(pEntity);
+
+        CHECK(!pScene->getEntity(handle));
+        CHECK(!pScene->getComponent(transformsHandle));
+        CHECK_EQUAL(pEntity, pScene2->getEntity(pEntity->getHandle()));
+        CHECK_EQUAL(pEntity->getTransforms(),
+                    pScene2->getComponent(pEntity->getTransforms()->getHandle()));
+
+        pScene2->destroy(pEntity);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ArchetypesDisabledByDefault)
+    {
+        Entity* pEntity = pScene->create("test");
+
+        CHECK(!pScene->areArchetypesEnabled());
+        CHECK_EQUAL(0, pScene->getNbArchetypes());
+        CHECK(!pScene->getArchetype(pEntity));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, EntitiesGroupedByArchetype)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+
+        pScene->enableArchetypes();
+
+        Entity* pEntity2 = pScene->create("test2");
+        Entity* pEntity3 = pScene->create("test3");
+        Component* pComponent = Component::create("Comp", pEntity3->getComponentsList());
+
+        CHECK_EQUAL(2, pScene->getNbArchetypes());
+
+        Archetype* pArchetype = pScene->getArchetype(pEntity1);
+        CHECK(pArchetype);
+        CHECK_EQUAL(pArchetype, pScene->getArchetype(pEntity2));
+        CHECK_EQUAL(2, pArchetype->getNbEntities());
+        CHECK_EQUAL(1, pArchetype->getSignature().size());
+
+        unsigned int column = pArchetype->getColumn(Transforms::TYPE_ID);
+        CHECK_EQUAL(0, column);
+        CHECK_EQUAL(pEntity1, pArchetype->getEntities(0)[0]);
+        CHECK_EQUAL(pEntity1->getTransforms(), pArchetype->getComponents(0, column)[0]);
+        CHECK_EQUAL(pEntity2->getTransforms(), pArchetype->getComponents(0, column)[1]);
+
+        Archetype* pArchetype3 = pScene->getArchetype(pEntity3);
+        CHECK(pArchetype3 != pArchetype);
+        CHECK_EQUAL(1, pArchetype3->getNbEntities());
+        CHECK(pArchetype3->hasType(Transforms::TYPE_ID));
+        CHECK_EQUAL(pComponent,
+                    pArchetype3->getComponents(0, pArchetype3->getColumn(Component::TYPE_ID))[0]);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, EntityMovedToAnotherArchetype)
+    {
+        pScene->enableArchetypes();
+
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+
+        Archetype* pArchetype = pScene->getArchetype(pEntity1);
+
+        Component* pComponent = Component::create("Comp", pEntity1->getComponentsList());
+
+        Archetype* pArchetype2 = pScene->getArchetype(pEntity1);
+        CHECK(pArchetype2 != pArchetype);
+        CHECK_EQUAL(1, pArchetype->getNbEntities());
+        CHECK_EQUAL(pEntity2, pArchetype->getEntities(0)[0]);
+        CHECK_EQUAL(1, pArchetype2->getNbEntities());
+
+        // Back to the first archetype
+        pComponentsManager->destroy(pComponent);
+
+        CHECK_EQUAL(pArchetype, pScene->getArchetype(pEntity1));
+        CHECK_EQUAL(2, pArchetype->getNbEntities());
+        CHECK_EQUAL(0, pArchetype2->getNbEntities());
+        CHECK_EQUAL(2, pScene->getNbArchetypes());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ArchetypesAfterDestruction)
+    {
+        pScene->enableArchetypes();
+
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+        Entity* pEntity3 = pScene->create("test3");
+
+        Archetype* pArchetype = pScene->getArchetype(pEntity1);
+        CHECK_EQUAL(3, pArchetype->getNbEntities());
+
+        pScene->destroy(pEntity1);
+
+        CHECK_EQUAL(2, pArchetype->getNbEntities());
+        CHECK_EQUAL(pArchetype, pScene->getArchetype(pEntity2));
+        CHECK_EQUAL(pArchetype, pScene->getArchetype(pEntity3));
+
+        // The last entity was moved in the hole
+        CHECK_EQUAL(pEntity3, pArchetype->getEntities(0)[0]);
+        CHECK_EQUAL(pEntity3->getTransforms(), pArchetype->getComponents(0, 0)[0]);
+
+        // A recycled entity is classified again
+        Entity* pEntity4 = pScene->create("test4");
+
+        CHECK_EQUAL(pArchetype, pScene->getArchetype(pEntity4));
+        CHECK_EQUAL(3, pArchetype->getNbEntities());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ArchetypesAfterTransfer)
+    {
+        Scene*  pScene2 = new Scene("second");
+        pScene->enableArchetypes();
+        pScene2->enableArchetypes();
+
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+
+        Archetype* pArchetype = pScene->getArchetype(pEntity1);
+
+        pScene2->transfer(pEntity1);
+
+        CHECK_EQUAL(1, pArchetype->getNbEntities());
+        CHECK_EQUAL(pEntity2, pArchetype->getEntities(0)[0]);
+
+        Archetype* pArchetype2 = pScene2->getArchetype(pEntity1);
+        CHECK(pArchetype2);
+        CHECK(pArchetype2 != pArchetype);
+        CHECK_EQUAL(1, pArchetype2->getNbEntities());
+
+        pScene2->destroy(pEntity1);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransferOfAnUnclassifiedEntity)
+    {
+        Scene*  pScene2 = new Scene("second");
+        pScene->enableArchetypes();
+        pScene2->enableArchetypes();
+
+        // Modified several times before being transferred, without any query
+        Entity* pEntity1 = pScene->create("test1");
+        Component::create("Comp1", pEntity1->getComponentsList());
+        Component::create("Comp2", pEntity1->getComponentsList());
+        Entity* pEntity2 = pScene->create("test2");
+
+        pScene2->transfer(pEntity1);
+
+        CHECK_EQUAL(1, pScene->getNbArchetypes());
+        CHECK_EQUAL(1, pScene->getArchetype(pEntity2)->getNbEntities());
+
+        Archetype* pArchetype = pScene2->getArchetype(pEntity1);
+        CHECK(pArchetype);
+        CHECK_EQUAL(3, pArchetype->getSignature().size());
+        CHECK_EQUAL(1, pScene2->getNbArchetypes());
+
+        pScene2->destroy(pEntity1);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ArchetypesDisabling)
+    {
+        pScene->enableArchetypes();
+
+        Entity* pEntity = pScene->create("test");
+        CHECK(pScene->getArchetype(pEntity));
+
+        pScene->enableArchetypes(false);
+
+        CHECK(!pScene->areArchetypesEnabled());
+        CHECK_EQUAL(0, pScene->getNbArchetypes());
+        CHECK(!pScene->getArchetype(pEntity));
+
+        Component::create("Comp", pEntity->getComponentsList());
+        CHECK(!pScene->getArchetype(pEntity));
+    }
+
+
     TEST_FIXTURE(EntitiesTestEnvironment, EntityTransfer)
     {
         Scene*  pScene2 = new Scene("second");
@@ -101,12 +635,716 @@ SUITE(SceneTests)
         delete pScene2;
     }
 
+
+    TEST_FIXTURE(EntitiesTestEnvironment, EntitiesIndexAfterTransfer)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+
+        pScene2->transfer("test1", pScene);
+
+        CHECK(!pScene->getEntity("test1"));
+        CHECK_EQUAL(pEntity2, pScene->getEntity("test2"));
+        CHECK_EQUAL(pEntity2, pScene->getEntity((unsigned int) 0));
+
+        CHECK_EQUAL(pEntity1, pScene2->getEntity("test1"));
+        CHECK_EQUAL(pEntity1, pScene2->getEntity((unsigned int) 0));
+
+        pScene2->destroy("test1");
+        delete pScene2;
+    }
+
     TEST_FIXTURE(EntitiesTestEnvironment, NoMainComponentByDefault)
     {
         CHECK(!pScene->getMainComponent(COMP_VISUAL));
         CHECK(!pScene->getMainComponent(COMP_AUDIO));
         CHECK(!pScene->getMainComponent(COMP_PHYSICAL));
     }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransformsUpdate)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild1 = pScene->create("child1", pParent);
+        Entity* pChild2 = pScene->create("child2", pParent);
+
+        pParent->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pChild1->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+        pChild2->getTransforms()->setPosition(0.0f, 0.0f, 10.0f);
+
+        pScene->updateTransforms();
+
+        TransformsStore* pStore = pScene->getTransformsStore();
+        CHECK(!pStore->isDirty(pChild1->getTransforms()->getStoreIndex()));
+        CHECK(!pStore->isDirty(pChild2->getTransforms()->getStoreIndex()));
+
+        CHECK(Vector3(10.0f, 10.0f, 0.0f).positionEquals(pChild1->getTransforms()->getWorldPosition()));
+        CHECK(Vector3(10.0f, 0.0f, 10.0f).positionEquals(pChild2->getTransforms()->getWorldPosition()));
+
+        pParent->getTransforms()->translate(5.0f, 0.0f, 0.0f);
+
+        CHECK(pStore->isDirty(pChild1->getTransforms()->getStoreIndex()));
+
+        pScene->updateTransforms();
+
+        CHECK(Vector3(15.0f, 10.0f, 0.0f).positionEquals(pStore->getWorldPosition(pChild1->getTransforms()->getStoreIndex())));
+
+        pScene->destroy(pChild2);
+        pScene->destroy(pChild1);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransformsInterpolation)
+    {
+        Entity* pEntity = pScene->create("test");
+        Transforms* pTransforms = pEntity->getTransforms();
+
+        pScene->setTransformsInterpolationEnabled(true);
+        CHECK(pScene->isTransformsInterpolationEnabled());
+
+        pTransforms->setPosition(10.0f, 0.0f, 0.0f);
+        pScene->commitFrame();
+
+        pTransforms->setPosition(20.0f, 0.0f, 0.0f);
+        pTransforms->setOrientation(Quaternion(Degree(90.0f), Vector3::UNIT_Y));
+        pTransforms->setScale(3.0f, 3.0f, 3.0f);
+        pScene->commitFrame();
+
+        // Changes made after the last frame aren't taken into account
+        pTransforms->setPosition(100.0f, 0.0f, 0.0f);
+
+        Vector3 position;
+        Quaternion orientation;
+        Vector3 scale;
+
+        pTransforms->getInterpolatedWorldTransforms(0.0f, position, orientation, scale);
+        CHECK(Vector3(10.0f, 0.0f, 0.0f).positionEquals(position));
+        CHECK(orientation.equals(Quaternion::IDENTITY, Degree(0.1f)));
+        CHECK(Vector3(1.0f, 1.0f, 1.0f).positionEquals(scale));
+
+        pTransforms->getInterpolatedWorldTransforms(0.5f, position, orientation, scale);
+        CHECK(Vector3(15.0f, 0.0f, 0.0f).positionEquals(position));
+        CHECK(orientation.equals(Quaternion(Degree(45.0f), Vector3::UNIT_Y), Degree(0.1f)));
+        CHECK(Vector3(2.0f, 2.0f, 2.0f).positionEquals(scale));
+
+        pTransforms->getInterpolatedWorldTransforms(0.5f, position, orientation, scale, true);
+        CHECK(orientation.equals(Quaternion(Degree(45.0f), Vector3::UNIT_Y), Degree(0.1f)));
+
+        pTransforms->getInterpolatedWorldTransforms(1.0f, position, orientation, scale);
+        CHECK(Vector3(20.0f, 0.0f, 0.0f).positionEquals(position));
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransformsInterpolationOfANewEntity)
+    {
+        pScene->setTransformsInterpolationEnabled(true);
+        pScene->commitFrame();
+
+        Entity* pEntity = pScene->create("test");
+        pEntity->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+
+        pScene->commitFrame();
+
+        Vector3 position;
+        Quaternion orientation;
+        Vector3 scale;
+
+        pEntity->getTransforms()->getInterpolatedWorldTransforms(0.0f, position, orientation, scale);
+        CHECK(Vector3(10.0f, 0.0f, 0.0f).positionEquals(position));
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransformsWithoutInterpolation)
+    {
+        Entity* pEntity = pScene->create("test");
+        pEntity->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+
+        CHECK(!pScene->isTransformsInterpolationEnabled());
+
+        Vector3 position;
+        Quaternion orientation;
+        Vector3 scale;
+
+        pEntity->getTransforms()->getInterpolatedWorldTransforms(0.0f, position, orientation, scale);
+        CHECK(Vector3(10.0f, 0.0f, 0.0f).positionEquals(position));
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, WorldMatricesExport)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+
+        pParent->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+
+        float buffer[32];
+        unsigned int indices[2];
+
+        CHECK_EQUAL(2, pScene->exportWorldMatrices(buffer, 0, indices));
+        CHECK_EQUAL(0, indices[0]);
+        CHECK_EQUAL(1, indices[1]);
+
+        const Matrix4& matrix = pChild->getTransforms()->getWorldMatrix();
+        for (unsigned int i = 0; i < 16; ++i)
+            CHECK_EQUAL(matrix[i / 4][i % 4], buffer[16 + i]);
+
+        CHECK_EQUAL(10.0f, buffer[3]);
+        CHECK_EQUAL(10.0f, buffer[16 + 3]);
+        CHECK_EQUAL(10.0f, buffer[16 + 7]);
+
+        pScene->destroy(pChild);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, WorldMatricesExportOfChangedEntities)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+        Entity* pEntity3 = pScene->create("test3");
+
+        float buffer[48];
+        unsigned int indices[3];
+
+        pScene->commitFrame();
+        unsigned int frame = pScene->getFrame();
+
+        CHECK_EQUAL(0, pScene->exportWorldMatrices(buffer, frame, indices));
+
+        pEntity3->getTransforms()->setPosition(30.0f, 0.0f, 0.0f);
+        pScene->commitFrame();
+
+        CHECK_EQUAL(1, pScene->exportWorldMatrices(buffer, frame, indices));
+        CHECK_EQUAL(2, indices[0]);
+        CHECK_EQUAL(30.0f, buffer[3]);
+
+        CHECK_EQUAL(3, pScene->exportWorldMatrices(buffer));
+
+        pScene->destroy(pEntity1);
+        pScene->destroy(pEntity2);
+        pScene->destroy(pEntity3);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, WorldMatricesExportAfterDestruction)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+        Entity* pEntity3 = pScene->create("test3");
+
+        pEntity3->getTransforms()->setPosition(30.0f, 0.0f, 0.0f);
+
+        float buffer[48];
+        unsigned int indices[3];
+
+        pScene->commitFrame();
+        unsigned int frame = pScene->getFrame();
+
+        CHECK_EQUAL(0, pScene->exportWorldMatrices(buffer, frame, indices));
+
+        // The last entity is moved at the index of the destroyed one
+        pScene->destroy(pEntity1);
+
+        CHECK_EQUAL(1, pScene->exportWorldMatrices(buffer, frame, indices));
+        CHECK_EQUAL(0, indices[0]);
+        CHECK_EQUAL(pEntity3, pScene->getEntity(indices[0]));
+        CHECK_EQUAL(30.0f, buffer[3]);
+
+        // Nothing moves when the last entity is destroyed
+        pScene->commitFrame();
+        frame = pScene->getFrame();
+
+        pScene->destroy(pEntity2);
+
+        CHECK_EQUAL(0, pScene->exportWorldMatrices(buffer, frame, indices));
+
+        pScene->destroy(pEntity3);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, WorldMatricesExportOfSomeEntities)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+
+        pEntity2->getTransforms()->setPosition(20.0f, 0.0f, 0.0f);
+
+        Entity::tEntitiesList entities;
+        entities.push_back(pEntity2);
+
+        float buffer[16];
+        unsigned int indices[1];
+
+        CHECK_EQUAL(1, pScene->exportWorldMatrices(entities, buffer, 0, indices));
+        CHECK_EQUAL(0, indices[0]);
+        CHECK_EQUAL(20.0f, buffer[3]);
+
+        pScene->destroy(pEntity1);
+        pScene->destroy(pEntity2);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, OriginRebasing)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+
+        pParent->getTransforms()->setPosition(1000.0f, 0.0f, 0.0f);
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+
+        pScene->updateTransforms();
+
+        pScene->rebaseOrigin(Vector3(1000.0f, 0.0f, 0.0f));
+
+        CHECK(tAbsolutePosition(1000.0, 0.0, 0.0) == pScene->getOrigin());
+
+        // Only the root was moved, and the world transforms are still up-to-date
+        CHECK(Vector3::ZERO.positionEquals(pParent->getTransforms()->getPosition()));
+        CHECK(Vector3(0.0f, 10.0f, 0.0f).positionEquals(pChild->getTransforms()->getPosition()));
+
+        TransformsStore* pStore = pScene->getTransformsStore();
+        CHECK(!pStore->isDirty(pChild->getTransforms()->getStoreIndex()));
+
+        CHECK(Vector3(0.0f, 10.0f, 0.0f).positionEquals(pChild->getTransforms()->getWorldPosition()));
+        CHECK_EQUAL(10.0f, pChild->getTransforms()->getWorldMatrix()[1][3]);
+
+        tAbsolutePosition position = pChild->getTransforms()->getAbsoluteWorldPosition();
+        CHECK_EQUAL(1000.0, position.x);
+        CHECK_EQUAL(10.0, position.y);
+        CHECK_EQUAL(0.0, position.z);
+
+        pScene->destroy(pChild);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, OriginRebasingOfDirtyTransforms)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+
+        pParent->getTransforms()->setPosition(1000.0f, 0.0f, 0.0f);
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+
+        pScene->rebaseOrigin(Vector3(1000.0f, 0.0f, 0.0f));
+
+        CHECK(Vector3(0.0f, 10.0f, 0.0f).positionEquals(pChild->getTransforms()->getWorldPosition()));
+
+        pScene->destroy(pChild);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, AbsolutePositionInALargeWorld)
+    {
+        Entity* pEntity = pScene->create("test");
+        Transforms* pTransforms = pEntity->getTransforms();
+
+        pScene->rebaseOrigin(Vector3(10000000.0f, 0.0f, 0.0f));
+
+        // Not representable with a float
+        pTransforms->setAbsoluteWorldPosition(tAbsolutePosition(10000000.25, 0.0, 0.0));
+
+        CHECK_EQUAL(0.25f, pTransforms->getWorldPosition().x);
+        CHECK_EQUAL(10000000.25, pTransforms->getAbsoluteWorldPosition().x);
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, AbsolutePositionOfAChild)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+
+        pScene->rebaseOrigin(Vector3(1000.0f, 0.0f, 0.0f));
+
+        pParent->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pParent->getTransforms()->setOrientation(Quaternion(Degree(90.0f), Vector3::UNIT_Y));
+        pParent->getTransforms()->setScale(2.0f, 2.0f, 2.0f);
+
+        pChild->getTransforms()->setAbsoluteWorldPosition(tAbsolutePosition(1010.0, 0.0, 10.0));
+
+        CHECK(Vector3(10.0f, 0.0f, 10.0f).positionEquals(pChild->getTransforms()->getWorldPosition()));
+
+        tAbsolutePosition position = pChild->getTransforms()->getAbsoluteWorldPosition();
+        CHECK_CLOSE(1010.0, position.x, 1e-3);
+        CHECK_CLOSE(0.0, position.y, 1e-3);
+        CHECK_CLOSE(10.0, position.z, 1e-3);
+
+        pScene->destroy(pChild);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, OriginRebasingWithInterpolation)
+    {
+        Entity* pEntity = pScene->create("test");
+        Transforms* pTransforms = pEntity->getTransforms();
+
+        pScene->setTransformsInterpolationEnabled(true);
+
+        pTransforms->setPosition(1000.0f, 0.0f, 0.0f);
+        pScene->commitFrame();
+
+        pTransforms->setPosition(1010.0f, 0.0f, 0.0f);
+        pScene->commitFrame();
+
+        pScene->rebaseOrigin(Vector3(1000.0f, 0.0f, 0.0f));
+
+        Vector3 position;
+        Quaternion orientation;
+        Vector3 scale;
+
+        pTransforms->getInterpolatedWorldTransforms(0.5f, position, orientation, scale);
+        CHECK(Vector3(5.0f, 0.0f, 0.0f).positionEquals(position));
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, EntityTransferBetweenOrigins)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pEntity = pScene->create("test");
+
+        pEntity->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+
+        pScene2->rebaseOrigin(Vector3(100.0f, 0.0f, 0.0f));
+        pScene2->transfer(pEntity);
+
+        CHECK(Vector3(-90.0f, 0.0f, 0.0f).positionEquals(pEntity->getTransforms()->getWorldPosition()));
+        CHECK_EQUAL(10.0, pEntity->getTransforms()->getAbsoluteWorldPosition().x);
+
+        pScene2->destroy(pEntity);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SpatialIndexQueries)
+    {
+        Entity* pEntity1 = pScene->create("entity1");
+        Entity* pEntity2 = pScene->create("entity2");
+        Entity* pEntity3 = pScene->create("entity3");
+
+        pEntity1->getTransforms()->setPosition(1.0f, 0.0f, 0.0f);
+        pEntity2->getTransforms()->setPosition(5.0f, 0.0f, 0.0f);
+        pEntity3->getTransforms()->setPosition(50.0f, 0.0f, 0.0f);
+
+        CHECK(!pScene->isSpatialIndexEnabled());
+        CHECK(!pScene->getSpatialIndex());
+
+        // The existing entities are indexed
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        CHECK(pScene->isSpatialIndexEnabled());
+        CHECK_EQUAL(3, pScene->getSpatialIndex()->getNbEntities());
+
+        Entity::tEntitiesList entities;
+        pScene->getEntitiesInRadius(Vector3::ZERO, 10.0f, entities);
+        CHECK_EQUAL(2, entities.size());
+
+        entities.clear();
+        pScene->getEntitiesInBox(Vector3(40.0f, -1.0f, -1.0f), Vector3(60.0f, 1.0f, 1.0f), entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity3, entities[0]);
+
+        entities.clear();
+        pScene->getNearestEntities(Vector3(4.0f, 0.0f, 0.0f), 2, entities);
+        CHECK_EQUAL(2, entities.size());
+        CHECK_EQUAL(pEntity2, entities[0]);
+        CHECK_EQUAL(pEntity1, entities[1]);
+
+        pScene->enableSpatialIndex(false);
+        CHECK(!pScene->isSpatialIndexEnabled());
+
+        pScene->destroyAll();
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SpatialIndexUpdate)
+    {
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        Entity* pEntity1 = pScene->create("entity1");
+        Entity* pEntity2 = pScene->create("entity2");
+
+        pEntity2->getTransforms()->setPosition(100.0f, 0.0f, 0.0f);
+
+        Entity::tEntitiesList entities;
+        pScene->getEntitiesInRadius(Vector3::ZERO, 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity1, entities[0]);
+
+        pEntity1->getTransforms()->setPosition(100.0f, 0.0f, 1.0f);
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3::ZERO, 1.0f, entities);
+        CHECK(entities.empty());
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3(100.0f, 0.0f, 0.0f), 2.0f, entities);
+        CHECK_EQUAL(2, entities.size());
+
+        // The destroyed entities are removed from the index
+        pScene->destroy(pEntity1);
+
+        CHECK_EQUAL(1, pScene->getSpatialIndex()->getNbEntities());
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3(100.0f, 0.0f, 0.0f), 2.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity2, entities[0]);
+
+        pScene->destroy(pEntity2);
+        CHECK_EQUAL(0, pScene->getSpatialIndex()->getNbEntities());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SpatialIndexOfAHierarchy)
+    {
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+        Entity* pNewParent = pScene->create("new_parent");
+
+        pChild->getTransforms()->setPosition(0.0f, 5.0f, 0.0f);
+        pNewParent->getTransforms()->setPosition(100.0f, 0.0f, 0.0f);
+
+        // Moving the parent moves the child
+        pParent->getTransforms()->setPosition(50.0f, 0.0f, 0.0f);
+
+        Entity::tEntitiesList entities;
+        pScene->getEntitiesInRadius(Vector3(50.0f, 5.0f, 0.0f), 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pChild, entities[0]);
+
+        // Reparenting
+        pNewParent->addChild(pChild);
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3(50.0f, 5.0f, 0.0f), 1.0f, entities);
+        CHECK(entities.empty());
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3(100.0f, 5.0f, 0.0f), 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pChild, entities[0]);
+
+        // Destruction of a subtree
+        pScene->destroy(pNewParent);
+
+        CHECK_EQUAL(1, pScene->getSpatialIndex()->getNbEntities());
+
+        pScene->destroyAll();
+        CHECK_EQUAL(0, pScene->getSpatialIndex()->getNbEntities());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SpatialIndexAfterRebasing)
+    {
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        Entity* pEntity = pScene->create("test");
+        pEntity->getTransforms()->setPosition(1000.0f, 0.0f, 0.0f);
+
+        Entity::tEntitiesList entities;
+        pScene->getEntitiesInRadius(Vector3(1000.0f, 0.0f, 0.0f), 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+
+        pScene->updateTransforms();
+        pScene->rebaseOrigin(Vector3(1000.0f, 0.0f, 0.0f));
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3::ZERO, 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity, entities[0]);
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SpatialIndexAfterTransfer)
+    {
+        Scene* pScene2 = new Scene("second");
+
+        pScene->enableSpatialIndex(true, 10.0f);
+        pScene2->enableSpatialIndex(true, 10.0f);
+
+        Entity* pEntity = pScene->create("test");
+        Entity* pOther = pScene->create("other");
+
+        pEntity->getTransforms()->setPosition(10.0f, 10.0f, 0.0f);
+        pOther->getTransforms()->setPosition(10.0f, 10.0f, 0.0f);
+        pEntity->setBounds(tBounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)));
+
+        CHECK_EQUAL(2, pScene->getSpatialIndex()->getNbEntities());
+        CHECK(pScene->getBoundsHierarchy()->contains(pEntity));
+
+        pScene2->transfer(pEntity);
+
+        CHECK(!pScene->getBoundsHierarchy()->contains(pEntity));
+        CHECK(pScene2->getBoundsHierarchy()->contains(pEntity));
+
+        CHECK_EQUAL(1, pScene->getSpatialIndex()->getNbEntities());
+        CHECK_EQUAL(1, pScene2->getSpatialIndex()->getNbEntities());
+        CHECK(pScene->getSpatialIndex()->contains(pOther));
+        CHECK(pScene2->getSpatialIndex()->contains(pEntity));
+
+        Entity::tEntitiesList entities;
+        pScene2->getEntitiesInRadius(Vector3(10.0f, 10.0f, 0.0f), 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity, entities[0]);
+
+        entities.clear();
+        pScene->getEntitiesInRadius(Vector3(10.0f, 10.0f, 0.0f), 1.0f, entities);
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pOther, entities[0]);
+
+        pScene2->destroyAll();
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RayCast)
+    {
+        tBounds bounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+
+        Entity* pEntity1 = pScene->create("entity1");
+        Entity* pEntity2 = pScene->create("entity2");
+        Entity* pEntity3 = pScene->create("entity3");
+
+        pEntity1->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pEntity2->getTransforms()->setPosition(20.0f, 0.0f, 0.0f);
+        pEntity3->getTransforms()->setPosition(30.0f, 0.0f, 0.0f);
+
+        // The bounds set before the index is enabled are taken into account
+        pEntity1->setBounds(bounds);
+        pEntity2->setBounds(bounds);
+
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        pEntity3->setBounds(bounds);
+
+        CHECK_EQUAL(3, pScene->getBoundsHierarchy()->getNbEntities());
+
+        BoundsHierarchy::tRayHit hits[4];
+        unsigned int nbHits = pScene->castRay(Vector3::ZERO, Vector3::UNIT_X, 100.0f, hits, 4);
+
+        CHECK_EQUAL(3, nbHits);
+        CHECK_EQUAL(pEntity1, hits[0].pEntity);
+        CHECK_EQUAL(pEntity2, hits[1].pEntity);
+        CHECK_EQUAL(pEntity3, hits[2].pEntity);
+        CHECK_CLOSE(9.0f, hits[0].distance, 1e-4f);
+
+        // Moved entity
+        pEntity1->getTransforms()->setPosition(10.0f, 5.0f, 0.0f);
+
+        nbHits = pScene->castRay(Vector3::ZERO, Vector3::UNIT_X, 100.0f, hits, 4);
+        CHECK_EQUAL(2, nbHits);
+        CHECK_EQUAL(pEntity2, hits[0].pEntity);
+
+        // Scaled entity
+        pEntity1->getTransforms()->setScale(10.0f, 10.0f, 10.0f);
+
+        nbHits = pScene->castRay(Vector3::ZERO, Vector3::UNIT_X, 100.0f, hits, 4);
+        CHECK_EQUAL(3, nbHits);
+        CHECK_EQUAL(pEntity1, hits[0].pEntity);
+        CHECK_CLOSE(0.0f, hits[0].distance, 1e-4f);
+
+        // Removed bounds
+        pEntity1->removeBounds();
+
+        nbHits = pScene->castRay(Vector3::ZERO, Vector3::UNIT_X, 100.0f, hits, 4);
+        CHECK_EQUAL(2, nbHits);
+        CHECK_EQUAL(2, pScene->getBoundsHierarchy()->getNbEntities());
+
+        // Destroyed entity
+        pScene->destroy(pEntity2);
+
+        nbHits = pScene->castRay(Vector3::ZERO, Vector3::UNIT_X, 100.0f, hits, 4);
+        CHECK_EQUAL(1, nbHits);
+        CHECK_EQUAL(pEntity3, hits[0].pEntity);
+
+        pScene->destroyAll();
+        CHECK_EQUAL(0, pScene->getBoundsHierarchy()->getNbEntities());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RayCastOfAHierarchy)
+    {
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+        Entity* pNewParent = pScene->create("new_parent");
+
+        pChild->setBounds(tBounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)));
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+        pNewParent->getTransforms()->setPosition(100.0f, 0.0f, 0.0f);
+
+        // Moving the parent moves the bounds of the child
+        pParent->getTransforms()->setPosition(50.0f, 0.0f, 0.0f);
+
+        BoundsHierarchy::tRayHit hits[2];
+        CHECK_EQUAL(1, pScene->castRay(Vector3(50.0f, 0.0f, 0.0f), Vector3::UNIT_Y, 100.0f, hits, 2));
+        CHECK_EQUAL(pChild, hits[0].pEntity);
+
+        // Reparenting
+        pNewParent->addChild(pChild);
+
+        CHECK_EQUAL(0, pScene->castRay(Vector3(50.0f, 0.0f, 0.0f), Vector3::UNIT_Y, 100.0f, hits, 2));
+        CHECK_EQUAL(1, pScene->castRay(Vector3(100.0f, 0.0f, 0.0f), Vector3::UNIT_Y, 100.0f, hits, 2));
+
+        pScene->destroyAll();
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, FrustumCulling)
+    {
+        pScene->enableSpatialIndex(true, 10.0f);
+
+        Entity* entities[10];
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            std::ostringstream str;
+            str << "entity" << i;
+
+            entities[i] = pScene->create(str.str());
+            entities[i]->setBounds(tBounds(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)));
+            entities[i]->getTransforms()->setPosition(0.0f, 0.0f, -10.0f * i);
+        }
+
+        // Orthographic projection of the box [-10, 10] x [-5, 5] x [-45, -15]
+        Matrix4 projection(0.1f, 0.0f, 0.0f, 0.0f,
+                           0.0f, 0.2f, 0.0f, 0.0f,
+                           0.0f, 0.0f, -2.0f / 30.0f, -60.0f / 30.0f,
+                           0.0f, 0.0f, 0.0f, 1.0f);
+
+        Entity* pVisible[10];
+        unsigned int nbVisible = pScene->getEntitiesInFrustum(tFrustum::fromMatrix(projection),
+                                                              pVisible, 10);
+
+        CHECK_EQUAL(3, nbVisible);
+        for (unsigned int i = 2; i <= 4; ++i)
+            CHECK(std::find(pVisible, pVisible + nbVisible, entities[i]) != pVisible + nbVisible);
+
+        entities[0]->getTransforms()->setPosition(0.0f, 0.0f, -30.0f);
+
+        CHECK_EQUAL(4, pScene->getEntitiesInFrustum(tFrustum::fromMatrix(projection), pVisible, 10));
+
+        pScene->destroyAll();
+    }
 }
 
 
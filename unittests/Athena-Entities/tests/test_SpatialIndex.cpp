@@ -0,0 +1,213 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/SpatialIndex.h>
+#include <Athena-Entities/Scene.h>
+#include <sstream>
+#include <algorithm>
+#include "../environments/EntitiesTestEnvironment.h"
+
+
+using namespace Athena::Entities;
+using namespace Athena::Math;
+
+
+// The entries of the index are identified by the handles of the entities
+static Entity* createEntity(Scene* pScene, unsigned int index)
+{
+    std::ostringstream str;
+    str << "entity" << index;
+    return pScene->create(str.str());
+}
+
+
+static bool contains(const Entity::tEntitiesList& entities, Entity* pEntity)
+{
+    return (std::find(entities.begin(), entities.end(), pEntity) != entities.end());
+}
+
+
+SUITE(SpatialIndexTests)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, Creation)
+    {
+        SpatialIndex index(5.0f);
+
+        CHECK_EQUAL(5.0f, index.getCellSize());
+        CHECK_EQUAL(0, index.getNbEntities());
+        CHECK_EQUAL(0, index.getNbCells());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, AddEntities)
+    {
+        SpatialIndex index(10.0f);
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+        Entity* pEntity3 = createEntity(pScene, 3);
+
+        index._update(pEntity1, Vector3(1.0f, 1.0f, 1.0f));
+        index._update(pEntity2, Vector3(2.0f, 2.0f, 2.0f));
+        index._update(pEntity3, Vector3(-1.0f, 1.0f, 1.0f));
+
+        CHECK_EQUAL(3, index.getNbEntities());
+        CHECK_EQUAL(2, index.getNbCells());
+        CHECK(index.contains(pEntity1));
+        CHECK(index.contains(pEntity3));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, MoveEntity)
+    {
+        SpatialIndex index(10.0f);
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+
+        index._update(pEntity1, Vector3(1.0f, 1.0f, 1.0f));
+        index._update(pEntity2, Vector3(2.0f, 2.0f, 2.0f));
+
+        // In the same cell
+        index._update(pEntity1, Vector3(5.0f, 1.0f, 1.0f));
+        CHECK_EQUAL(2, index.getNbEntities());
+        CHECK_EQUAL(1, index.getNbCells());
+
+        // In another cell
+        index._update(pEntity1, Vector3(25.0f, 1.0f, 1.0f));
+        CHECK_EQUAL(2, index.getNbEntities());
+        CHECK_EQUAL(2, index.getNbCells());
+
+        Entity::tEntitiesList entities;
+        index.getEntitiesInRadius(Vector3(25.0f, 0.0f, 0.0f), 2.0f, entities);
+
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity1, entities[0]);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RemoveEntity)
+    {
+        SpatialIndex index(10.0f);
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+        Entity* pEntity3 = createEntity(pScene, 3);
+
+        index._update(pEntity1, Vector3(1.0f, 1.0f, 1.0f));
+        index._update(pEntity2, Vector3(2.0f, 2.0f, 2.0f));
+        index._update(pEntity3, Vector3(50.0f, 1.0f, 1.0f));
+
+        index._remove(pEntity1);
+
+        CHECK_EQUAL(2, index.getNbEntities());
+        CHECK(!index.contains(pEntity1));
+
+        // The empty cells are released
+        index._remove(pEntity3);
+
+        CHECK_EQUAL(1, index.getNbEntities());
+        CHECK_EQUAL(1, index.getNbCells());
+
+        // Nothing happens with an entity not in the index
+        index._remove(pEntity3);
+        CHECK_EQUAL(1, index.getNbEntities());
+
+        Entity::tEntitiesList entities;
+        index.getEntitiesInRadius(Vector3::ZERO, 100.0f, entities);
+
+        CHECK_EQUAL(1, entities.size());
+        CHECK_EQUAL(pEntity2, entities[0]);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RadiusQuery)
+    {
+        SpatialIndex index(10.0f);
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+        Entity* pEntity3 = createEntity(pScene, 3);
+        Entity* pEntity4 = createEntity(pScene, 4);
+
+        index._update(pEntity1, Vector3(0.0f, 0.0f, 0.0f));
+        index._update(pEntity2, Vector3(-9.0f, 0.0f, 0.0f));
+        index._update(pEntity3, Vector3(0.0f, 0.0f, 11.0f));
+        index._update(pEntity4, Vector3(8.0f, 8.0f, 0.0f));
+
+        Entity::tEntitiesList entities;
+        index.getEntitiesInRadius(Vector3::ZERO, 10.0f, entities);
+
+        CHECK_EQUAL(2, entities.size());
+        CHECK(contains(entities, pEntity1));
+        CHECK(contains(entities, pEntity2));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, BoxQuery)
+    {
+        SpatialIndex index(10.0f);
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+        Entity* pEntity3 = createEntity(pScene, 3);
+
+        index._update(pEntity1, Vector3(0.0f, 0.0f, 0.0f));
+        index._update(pEntity2, Vector3(15.0f, -5.0f, 3.0f));
+        index._update(pEntity3, Vector3(15.0f, 5.0f, 3.0f));
+
+        Entity::tEntitiesList entities;
+        index.getEntitiesInBox(Vector3(-1.0f, -10.0f, -1.0f), Vector3(20.0f, 0.0f, 5.0f), entities);
+
+        CHECK_EQUAL(2, entities.size());
+        CHECK(contains(entities, pEntity1));
+        CHECK(contains(entities, pEntity2));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, NearestQuery)
+    {
+        SpatialIndex index(1.0f);
+
+        Entity* entities[5];
+        for (unsigned int i = 0; i < 5; ++i)
+        {
+            entities[i] = createEntity(pScene, i);
+            index._update(entities[i], Vector3(i * i * 3.0f, 0.0f, 0.0f));
+        }
+
+        Entity::tEntitiesList nearest;
+        index.getNearestEntities(Vector3(11.0f, 0.0f, 0.0f), 3, nearest);
+
+        // Sorted by distance
+        CHECK_EQUAL(3, nearest.size());
+        CHECK_EQUAL(entities[2], nearest[0]);
+        CHECK_EQUAL(entities[1], nearest[1]);
+        CHECK_EQUAL(entities[0], nearest[2]);
+
+        // Less entities than requested
+        nearest.clear();
+        index.getNearestEntities(Vector3(100.0f, 0.0f, 0.0f), 10, nearest);
+
+        CHECK_EQUAL(5, nearest.size());
+        CHECK_EQUAL(entities[4], nearest[0]);
+        CHECK_EQUAL(entities[0], nearest[4]);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, NearestQueryAcrossCells)
+    {
+        SpatialIndex index(10.0f);
+
+        Entity* pEntity1 = createEntity(pScene, 1);
+        Entity* pEntity2 = createEntity(pScene, 2);
+
+        // The entity of the cell of the point isn't the nearest one
+        index._update(pEntity1, Vector3(9.0f, 0.0f, 0.0f));
+        index._update(pEntity2, Vector3(10.5f, 0.0f, 0.0f));
+
+        Entity::tEntitiesList nearest;
+        index.getNearestEntities(Vector3(9.9f, 0.0f, 0.0f), 1, nearest);
+
+        CHECK_EQUAL(1, nearest.size());
+        CHECK_EQUAL(pEntity2, nearest[0]);
+    }
+}
@@ -3,6 +3,7 @@
 #include <Athena-Entities/Transforms.h>
 #include <Athena-Entities/Serialization.h>
 #include <Athena-Core/Data/Serialization.h>
+#include <sstream>
 #include "../environments/EntitiesTestEnvironment.h"
 
 
@@ -12,6 +13,23 @@ using namespace Athena::Utils;
 using namespace Athena::Math;
 
 
+class TransformsListener: public Component
+{
+public:
+    TransformsListener(const std::string& strName, ComponentsList* pList)
+    : Component(strName, pList), nbNotifications(0)
+    {
+    }
+
+    virtual void onTransformsChanged()
+    {
+        ++nbNotifications;
+    }
+
+    unsigned int nbNotifications;
+};
+
+
 SUITE(TransformsComponentCreationTests)
 {
     TEST_FIXTURE(EntitiesTestEnvironment, DirectCreation)
@@ -76,6 +94,158 @@ SUITE(TransformsComponentCreationTests)
         CHECK(!pTransforms1->getTransforms());
         CHECK(!pTransforms2->getTransforms());
     }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DestructionOfAParentWithManyChildren)
+    {
+        ComponentsList list;
+
+        Transforms* pParent = new Transforms("Parent", &list);
+
+        Transforms* children[100];
+        for (unsigned int i = 0; i < 100; ++i)
+        {
+            std::ostringstream str;
+            str << "Child" << i;
+
+            children[i] = new Transforms(str.str(), &list);
+            children[i]->setTransforms(pParent);
+        }
+
+        pComponentsManager->destroy(pParent);
+
+        for (unsigned int i = 0; i < 100; ++i)
+            CHECK(!children[i]->getTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, RemovalOfOneOfTheChildren)
+    {
+        ComponentsList list;
+
+        Transforms* pParent = new Transforms("Parent", &list);
+        TransformsListener* pListener1 = new TransformsListener("Listener1", &list);
+        TransformsListener* pListener2 = new TransformsListener("Listener2", &list);
+        TransformsListener* pListener3 = new TransformsListener("Listener3", &list);
+
+        pListener1->setTransforms(pParent);
+        pListener2->setTransforms(pParent);
+        pListener3->setTransforms(pParent);
+
+        pListener2->removeTransforms();
+        pParent->getWorldPosition();
+
+        pListener1->nbNotifications = 0;
+        pListener2->nbNotifications = 0;
+        pListener3->nbNotifications = 0;
+
+        pParent->setPosition(1.0f, 2.0f, 3.0f);
+
+        CHECK_EQUAL(1, pListener1->nbNotifications);
+        CHECK_EQUAL(0, pListener2->nbNotifications);
+        CHECK_EQUAL(1, pListener3->nbNotifications);
+
+        pComponentsManager->destroy(pListener1);
+        pParent->getWorldPosition();
+        pParent->setPosition(0.0f, 0.0f, 0.0f);
+
+        CHECK_EQUAL(2, pListener3->nbNotifications);
+    }
+}
+
+
+SUITE(TransformsComponentNotificationTests)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, ListenerIsNotifiedOnceUntilUpdate)
+    {
+        ComponentsList list;
+
+        Transforms* pRoot = new Transforms("Root", &list);
+        Transforms* pChild = new Transforms("Child", &list);
+        TransformsListener* pListener = new TransformsListener("Listener", &list);
+
+        pChild->setTransforms(pRoot);
+        pListener->setTransforms(pChild);
+        pChild->getWorldPosition();
+
+        pListener->nbNotifications = 0;
+
+        pRoot->translate(1.0f, 0.0f, 0.0f);
+        pRoot->translate(1.0f, 0.0f, 0.0f);
+        pChild->translate(0.0f, 1.0f, 0.0f);
+
+        CHECK_EQUAL(1, pListener->nbNotifications);
+
+        CHECK(Vector3(2.0f, 1.0f, 0.0f).positionEquals(pChild->getWorldPosition()));
+
+        pRoot->translate(1.0f, 0.0f, 0.0f);
+
+        CHECK_EQUAL(2, pListener->nbNotifications);
+        CHECK(Vector3(3.0f, 1.0f, 0.0f).positionEquals(pChild->getWorldPosition()));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DirtySubtreeIsNotNotifiedAgain)
+    {
+        ComponentsList list;
+
+        Transforms* pRoot = new Transforms("Root", &list);
+        Transforms* pChild = new Transforms("Child", &list);
+        TransformsListener* pListener = new TransformsListener("Listener", &list);
+
+        pChild->setTransforms(pRoot);
+        pListener->setTransforms(pChild);
+
+        // Only the root is up-to-date
+        pRoot->getWorldPosition();
+
+        pListener->nbNotifications = 0;
+
+        pRoot->translate(1.0f, 0.0f, 0.0f);
+
+        CHECK_EQUAL(0, pListener->nbNotifications);
+        CHECK(Vector3(1.0f, 0.0f, 0.0f).positionEquals(pChild->getWorldPosition()));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SetTransformNotifiesOnce)
+    {
+        ComponentsList list;
+
+        Transforms* pTransforms = new Transforms("Transforms", &list);
+        TransformsListener* pListener = new TransformsListener("Listener", &list);
+
+        pListener->setTransforms(pTransforms);
+        pTransforms->getWorldPosition();
+
+        pListener->nbNotifications = 0;
+
+        pTransforms->setTransform(Vector3(1.0f, 2.0f, 3.0f), Quaternion(Degree(90.0f), Vector3::UNIT_Y),
+                                  Vector3(2.0f, 2.0f, 2.0f));
+
+        CHECK_EQUAL(1, pListener->nbNotifications);
+        CHECK(Vector3(1.0f, 2.0f, 3.0f).positionEquals(pTransforms->getWorldPosition()));
+        CHECK(Quaternion(Degree(90.0f), Vector3::UNIT_Y).equals(pTransforms->getWorldOrientation(), Degree(0.1f)));
+        CHECK(Vector3(2.0f, 2.0f, 2.0f).positionEquals(pTransforms->getWorldScale()));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ChangeOfParentOfADirtyTransforms)
+    {
+        ComponentsList list;
+
+        Transforms* pRoot1 = new Transforms("Root1", &list);
+        Transforms* pRoot2 = new Transforms("Root2", &list);
+        Transforms* pChild = new Transforms("Child", &list);
+
+        pRoot1->setPosition(1.0f, 0.0f, 0.0f);
+        pRoot2->setPosition(2.0f, 0.0f, 0.0f);
+
+        pChild->setTransforms(pRoot1);
+        pChild->setTransforms(pRoot2);
+
+        CHECK(Vector3(2.0f, 0.0f, 0.0f).positionEquals(pChild->getWorldPosition()));
+    }
 }
 
 
@@ -1442,3 +1612,67 @@ SUITE(TransformsJSONDeserialization)
         delete pDelayedProperties;
     }
 }
+
+
+SUITE(TransformsComponentWorldMatrixTests)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, WorldMatrix)
+    {
+        ComponentsList list;
+
+        Transforms* pParent = new Transforms("Parent", &list);
+        Transforms* pChild = new Transforms("Child", &list);
+
+        pChild->setTransforms(pParent);
+
+        pParent->setPosition(10.0f, 0.0f, 0.0f);
+        pParent->setOrientation(Quaternion(Degree(90.0f), Vector3::UNIT_Y));
+        pChild->setPosition(0.0f, 0.0f, 10.0f);
+        pChild->setScale(2.0f, 2.0f, 2.0f);
+
+        Matrix4 expected;
+        expected.makeTransform(pChild->getWorldPosition(), pChild->getWorldScale(),
+                               pChild->getWorldOrientation());
+
+        CHECK(expected == pChild->getWorldMatrix());
+        CHECK(Vector3(20.0f, 0.0f, 0.0f).positionEquals(pChild->getWorldPosition()));
+        CHECK(Vector3(20.0f, 0.0f, 0.0f).positionEquals(pChild->transformPoint(Vector3::ZERO)));
+        CHECK(Vector3(20.0f, 0.0f, -2.0f).positionEquals(pChild->transformPoint(Vector3::UNIT_X)));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, InverseWorldMatrix)
+    {
+        ComponentsList list;
+
+        Transforms* pTransforms = new Transforms("Transforms", &list);
+
+        pTransforms->setPosition(10.0f, 20.0f, 30.0f);
+        pTransforms->setOrientation(Quaternion(Degree(45.0f), Vector3::UNIT_Z));
+        pTransforms->setScale(2.0f, 3.0f, 4.0f);
+
+        Vector3 point(1.0f, 2.0f, 3.0f);
+
+        CHECK(point.positionEquals(pTransforms->inverseTransformPoint(pTransforms->transformPoint(point))));
+        CHECK(Vector3::ZERO.positionEquals(pTransforms->inverseTransformPoint(Vector3(10.0f, 20.0f, 30.0f))));
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, WorldMatrixIsUpdatedWhenTheParentMoves)
+    {
+        ComponentsList list;
+
+        Transforms* pParent = new Transforms("Parent", &list);
+        Transforms* pChild = new Transforms("Child", &list);
+
+        pChild->setTransforms(pParent);
+        pChild->setPosition(1.0f, 0.0f, 0.0f);
+
+        CHECK(Vector3(1.0f, 0.0f, 0.0f).positionEquals(pChild->transformPoint(Vector3::ZERO)));
+
+        pParent->translate(0.0f, 5.0f, 0.0f);
+
+        CHECK(Vector3(1.0f, 5.0f, 0.0f).positionEquals(pChild->transformPoint(Vector3::ZERO)));
+        CHECK(Vector3::ZERO.positionEquals(pChild->inverseTransformPoint(Vector3(1.0f, 5.0f, 0.0f))));
+    }
+}
@@ -0,0 +1,127 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/TransformsBatch.h>
+#include "../environments/EntitiesTestEnvironment.h"
+
+
+using namespace Athena;
+using namespace Athena::Entities;
+using namespace Athena::Math;
+
+
+class BatchListener: public Component
+{
+public:
+    BatchListener(const std::string& strName, ComponentsList* pList)
+    : Component(strName, pList), nbNotifications(0)
+    {
+    }
+
+    virtual void onTransformsChanged()
+    {
+        ++nbNotifications;
+    }
+
+    unsigned int nbNotifications;
+};
+
+
+SUITE(TransformsBatchTests)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, NotificationsAreDeferred)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+        BatchListener* pListener = new BatchListener("Listener", pChild->getComponentsList());
+
+        pListener->setTransforms(pChild->getTransforms());
+        pChild->getTransforms()->getWorldPosition();
+        pListener->nbNotifications = 0;
+
+        {
+            TransformsBatch batch(pScene);
+
+            CHECK(pScene->getTransformsStore()->isInBatch());
+
+            pParent->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+            pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+            pChild->getTransforms()->setScale(2.0f, 2.0f, 2.0f);
+
+            CHECK_EQUAL(0, pListener->nbNotifications);
+            CHECK(!pScene->getTransformsStore()->isDirty(pChild->getTransforms()->getStoreIndex()));
+        }
+
+        CHECK(!pScene->getTransformsStore()->isInBatch());
+        CHECK_EQUAL(1, pListener->nbNotifications);
+        CHECK(Vector3(10.0f, 10.0f, 0.0f).positionEquals(pChild->getTransforms()->getWorldPosition()));
+        CHECK(Vector3(2.0f, 2.0f, 2.0f).positionEquals(pChild->getTransforms()->getWorldScale()));
+
+        pScene->destroy(pChild);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, NestedBatches)
+    {
+        Entity* pEntity = pScene->create("test");
+        pEntity->getTransforms()->getWorldPosition();
+
+        pScene->beginTransformsBatch();
+        pScene->beginTransformsBatch();
+
+        pEntity->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+
+        pScene->endTransformsBatch();
+
+        CHECK(pScene->getTransformsStore()->isInBatch());
+        CHECK(!pScene->getTransformsStore()->isDirty(pEntity->getTransforms()->getStoreIndex()));
+
+        pScene->endTransformsBatch();
+
+        CHECK(!pScene->getTransformsStore()->isInBatch());
+        CHECK(Vector3(10.0f, 0.0f, 0.0f).positionEquals(pEntity->getTransforms()->getWorldPosition()));
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, EntityDestroyedDuringTheBatch)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        Entity* pEntity2 = pScene->create("test2");
+
+        {
+            TransformsBatch batch(pScene);
+
+            pEntity1->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+            pEntity2->getTransforms()->setPosition(20.0f, 0.0f, 0.0f);
+
+            pScene->destroy(pEntity1);
+        }
+
+        CHECK(Vector3(20.0f, 0.0f, 0.0f).positionEquals(pEntity2->getTransforms()->getWorldPosition()));
+
+        pScene->destroy(pEntity2);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, OtherScenesAreNotAffected)
+    {
+        Scene* pScene2 = new Scene("second");
+        Entity* pEntity = pScene2->create("test");
+        pEntity->getTransforms()->getWorldPosition();
+
+        {
+            TransformsBatch batch(pScene);
+
+            pEntity->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+
+            CHECK(pScene2->getTransformsStore()->isDirty(pEntity->getTransforms()->getStoreIndex()));
+        }
+
+        pScene2->destroy(pEntity);
+        delete pScene2;
+    }
+}
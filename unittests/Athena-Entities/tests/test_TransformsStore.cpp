@@ -0,0 +1,324 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/ComponentsList.h>
+#include <Athena-Entities/Entity.h>
+#include <Athena-Entities/Transforms.h>
+#include <Athena-Entities/TransformsStore.h>
+#include "../environments/EntitiesTestEnvironment.h"
+#include <sstream>
+
+
+using namespace Athena;
+using namespace Athena::Entities;
+using namespace Athena::Math;
+
+
+SUITE(TransformsStoreTests)
+{
+    TEST_FIXTURE(EntitiesTestEnvironment, EntityTransformsUseTheStoreOfTheScene)
+    {
+        Entity* pEntity = pScene->create("test");
+
+        CHECK_EQUAL(pScene->getTransformsStore(), pEntity->getTransforms()->getStore());
+        CHECK_EQUAL(1, pScene->getTransformsStore()->getNbTransforms());
+        CHECK_EQUAL(pEntity->getTransforms(),
+                    pScene->getTransformsStore()->getTransforms(pEntity->getTransforms()->getStoreIndex()));
+
+        pScene->destroy(pEntity);
+
+        CHECK_EQUAL(0, pScene->getTransformsStore()->getNbTransforms());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransformsWithoutSceneUseTheDefaultStore)
+    {
+        ComponentsList list;
+
+        Transforms* pTransforms = new Transforms("Transforms", &list);
+
+        CHECK_EQUAL(TransformsStore::getDefault(), pTransforms->getStore());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, DataIsWrittenInTheStore)
+    {
+        Entity* pEntity = pScene->create("test");
+        Transforms* pTransforms = pEntity->getTransforms();
+        TransformsStore* pStore = pScene->getTransformsStore();
+
+        pTransforms->setPosition(10.0f, 20.0f, 30.0f);
+        pTransforms->setScale(2.0f, 2.0f, 2.0f);
+        pTransforms->setInheritScale(false);
+
+        CHECK(Vector3(10.0f, 20.0f, 30.0f).positionEquals(pStore->getPosition(pTransforms->getStoreIndex())));
+        CHECK(Vector3(2.0f, 2.0f, 2.0f).positionEquals(pStore->getScale(pTransforms->getStoreIndex())));
+        CHECK(!pStore->inheritScale(pTransforms->getStoreIndex()));
+        CHECK(pStore->isDirty(pTransforms->getStoreIndex()));
+
+        pTransforms->getWorldPosition();
+
+        CHECK(!pStore->isDirty(pTransforms->getStoreIndex()));
+        CHECK(Vector3(10.0f, 20.0f, 30.0f).positionEquals(pStore->getWorldPosition(pTransforms->getStoreIndex())));
+
+        pScene->destroy(pEntity);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ParentIndex)
+    {
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child");
+        TransformsStore* pStore = pScene->getTransformsStore();
+
+        TransformsStore::tIndex parentIndex = pParent->getTransforms()->getStoreIndex();
+        TransformsStore::tIndex childIndex = pChild->getTransforms()->getStoreIndex();
+
+        CHECK_EQUAL(TransformsStore::INVALID_INDEX, pStore->getParent(childIndex));
+
+        pParent->addChild(pChild);
+
+        CHECK_EQUAL(parentIndex, pStore->getParent(childIndex));
+        CHECK(!pStore->hasForeignParent(childIndex));
+
+        pParent->removeChild(pChild);
+
+        CHECK_EQUAL(TransformsStore::INVALID_INDEX, pStore->getParent(childIndex));
+
+        pScene->destroy(pChild);
+        pScene->destroy(pParent);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, SlotsAreReused)
+    {
+        Entity* pEntity1 = pScene->create("test1");
+        TransformsStore::tIndex index = pEntity1->getTransforms()->getStoreIndex();
+        pScene->destroy(pEntity1);
+
+        Entity* pEntity2 = pScene->create("test2");
+
+        CHECK_EQUAL(index, pEntity2->getTransforms()->getStoreIndex());
+        CHECK_EQUAL(1, pScene->getTransformsStore()->getNbSlots());
+        CHECK(Vector3::ZERO.positionEquals(pEntity2->getTransforms()->getPosition()));
+
+        pScene->destroy(pEntity2);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, TransferMovesTheData)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+
+        pParent->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+
+        pScene2->transfer(pParent);
+
+        CHECK_EQUAL(pScene2->getTransformsStore(), pParent->getTransforms()->getStore());
+        CHECK_EQUAL(1, pScene->getTransformsStore()->getNbTransforms());
+        CHECK_EQUAL(1, pScene2->getTransformsStore()->getNbTransforms());
+
+        CHECK(Vector3(10.0f, 0.0f, 0.0f).positionEquals(pParent->getTransforms()->getPosition()));
+        CHECK(Vector3(10.0f, 10.0f, 0.0f).positionEquals(pChild->getTransforms()->getWorldPosition()));
+
+        TransformsStore::tIndex childIndex = pChild->getTransforms()->getStoreIndex();
+        CHECK_EQUAL(TransformsStore::INVALID_INDEX, pScene->getTransformsStore()->getParent(childIndex));
+        CHECK(pScene->getTransformsStore()->hasForeignParent(childIndex));
+
+        pScene->destroy(pChild);
+        pScene2->destroy(pParent);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, UpdateComputesTheWorldTransforms)
+    {
+        Entity* pRoot = pScene->create("root");
+        Entity* pChild = pScene->create("child");
+        Entity* pGrandChild = pScene->create("grandchild");
+        TransformsStore* pStore = pScene->getTransformsStore();
+
+        // Create the children before their parents, to check that the order of the slots
+        // doesn't matter
+        pChild->addChild(pGrandChild);
+        pRoot->addChild(pChild);
+
+        pRoot->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pRoot->getTransforms()->setScale(2.0f, 2.0f, 2.0f);
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+        pGrandChild->getTransforms()->setPosition(0.0f, 0.0f, 10.0f);
+        pGrandChild->getTransforms()->setInheritScale(false);
+
+        pStore->update();
+
+        CHECK(!pStore->isDirty(pRoot->getTransforms()->getStoreIndex()));
+        CHECK(!pStore->isDirty(pChild->getTransforms()->getStoreIndex()));
+        CHECK(!pStore->isDirty(pGrandChild->getTransforms()->getStoreIndex()));
+
+        CHECK(Vector3(10.0f, 20.0f, 0.0f).positionEquals(pStore->getWorldPosition(pChild->getTransforms()->getStoreIndex())));
+        CHECK(Vector3(10.0f, 20.0f, 20.0f).positionEquals(pStore->getWorldPosition(pGrandChild->getTransforms()->getStoreIndex())));
+        CHECK(Vector3(2.0f, 2.0f, 2.0f).positionEquals(pStore->getWorldScale(pChild->getTransforms()->getStoreIndex())));
+        CHECK(Vector3(1.0f, 1.0f, 1.0f).positionEquals(pStore->getWorldScale(pGrandChild->getTransforms()->getStoreIndex())));
+
+        pScene->destroy(pGrandChild);
+        pScene->destroy(pChild);
+        pScene->destroy(pRoot);
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, UpdateUsesTheWorldTransformsOfForeignParents)
+    {
+        Scene*  pScene2 = new Scene("second");
+        Entity* pParent = pScene->create("parent");
+        Entity* pChild = pScene->create("child", pParent);
+
+        pParent->getTransforms()->setPosition(10.0f, 0.0f, 0.0f);
+        pChild->getTransforms()->setPosition(0.0f, 10.0f, 0.0f);
+
+        pScene2->transfer(pParent);
+
+        pScene->updateTransforms();
+
+        TransformsStore::tIndex childIndex = pChild->getTransforms()->getStoreIndex();
+        CHECK(!pScene->getTransformsStore()->isDirty(childIndex));
+        CHECK(Vector3(10.0f, 10.0f, 0.0f).positionEquals(pScene->getTransformsStore()->getWorldPosition(childIndex)));
+
+        pScene->destroy(pChild);
+        pScene2->destroy(pParent);
+        delete pScene2;
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, UpdateMatchesTheLazyComputation)
+    {
+        TransformsStore store;
+        ComponentsList list;
+        std::vector<Transforms*> transforms;
+
+        // Two levels of 20 children, with various transforms and inheritance settings
+        Transforms* pRoot = new Transforms("Root", &list);
+        pRoot->_setStore(&store);
+        pRoot->setPosition(1.0f, 2.0f, 3.0f);
+        pRoot->setOrientation(Quaternion(Degree(30.0f), Vector3::UNIT_X));
+        pRoot->setScale(2.0f, 2.0f, 2.0f);
+
+        for (unsigned int i = 0; i < 40; ++i)
+        {
+            std::ostringstream str;
+            str << "Transforms" << i;
+
+            Transforms* pTransforms = new Transforms(str.str(), &list);
+            pTransforms->_setStore(&store);
+            pTransforms->setTransforms(i < 20 ? pRoot : transforms[i - 20]);
+            pTransforms->setPosition(Real(i), 1.0f, -Real(i));
+            pTransforms->setOrientation(Quaternion(Degree(Real(i * 10)), Vector3(1.0f, 1.0f, 0.0f).normalisedCopy()));
+            pTransforms->setScale(1.0f, 0.5f + Real(i % 3), 1.0f);
+            pTransforms->setInheritOrientation(i % 4 != 1);
+            pTransforms->setInheritScale(i % 5 != 2);
+
+            transforms.push_back(pTransforms);
+        }
+
+        store.update();
+
+        std::vector<Vector3> positions;
+        std::vector<Quaternion> orientations;
+        std::vector<Vector3> scales;
+
+        for (unsigned int i = 0; i < transforms.size(); ++i)
+        {
+            TransformsStore::tIndex index = transforms[i]->getStoreIndex();
+
+            CHECK(!store.isDirty(index));
+
+            positions.push_back(store.getWorldPosition(index));
+            orientations.push_back(store.getWorldOrientation(index));
+            scales.push_back(store.getWorldScale(index));
+
+            store._setDirty(index);
+        }
+
+        for (unsigned int i = 0; i < transforms.size(); ++i)
+        {
+            CHECK(positions[i].positionEquals(transforms[i]->getWorldPosition(), 1e-4f));
+            CHECK(orientations[i].equals(transforms[i]->getWorldOrientation(), Degree(0.1f)));
+            CHECK(scales[i].positionEquals(transforms[i]->getWorldScale(), 1e-4f));
+        }
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ThreadsCount)
+    {
+        TransformsStore store;
+
+        CHECK_EQUAL(1, store.getNbThreads());
+
+        store.setNbThreads(4);
+        CHECK_EQUAL(4, store.getNbThreads());
+
+        store.setNbThreads(1);
+        CHECK_EQUAL(1, store.getNbThreads());
+    }
+
+
+    TEST_FIXTURE(EntitiesTestEnvironment, ParallelUpdateIsIdenticalToSerialUpdate)
+    {
+        Scene* pScene2 = new Scene("second");
+        std::vector<Entity*> entities1;
+        std::vector<Entity*> entities2;
+
+        pScene2->setNbTransformsThreads(4);
+
+        // 50 roots, with subtrees of various sizes and depths
+        for (unsigned int i = 0; i < 50; ++i)
+        {
+            std::ostringstream str;
+            str << "root" << i;
+
+            entities1.push_back(pScene->create(str.str()));
+            entities2.push_back(pScene2->create(str.str()));
+
+            for (unsigned int j = 0; j < i; ++j)
+            {
+                std::ostringstream str2;
+                str2 << "entity" << i << "_" << j;
+
+                Entity* pParent1 = entities1[entities1.size() - 1 - (j % 3)];
+                Entity* pParent2 = entities2[entities2.size() - 1 - (j % 3)];
+
+                entities1.push_back(pScene->create(str2.str(), pParent1));
+                entities2.push_back(pScene2->create(str2.str(), pParent2));
+            }
+        }
+
+        for (unsigned int i = 0; i < entities1.size(); ++i)
+        {
+            Real f = Real(i);
+
+            entities1[i]->getTransforms()->setPosition(f, 1.0f, -f);
+            entities1[i]->getTransforms()->setOrientation(Quaternion(Degree(f), Vector3::UNIT_Y));
+            entities1[i]->getTransforms()->setScale(1.0f + f * 0.01f, 1.0f, 1.0f);
+
+            entities2[i]->getTransforms()->setPosition(f, 1.0f, -f);
+            entities2[i]->getTransforms()->setOrientation(Quaternion(Degree(f), Vector3::UNIT_Y));
+            entities2[i]->getTransforms()->setScale(1.0f + f * 0.01f, 1.0f, 1.0f);
+        }
+
+        pScene->updateTransforms();
+        pScene2->updateTransforms();
+
+        for (unsigned int i = 0; i < entities1.size(); ++i)
+        {
+            TransformsStore::tIndex index1 = entities1[i]->getTransforms()->getStoreIndex();
+            TransformsStore::tIndex index2 = entities2[i]->getTransforms()->getStoreIndex();
+
+            CHECK(!pScene2->getTransformsStore()->isDirty(index2));
+            CHECK(pScene->getTransformsStore()->getWorldPosition(index1) == pScene2->getTransformsStore()->getWorldPosition(index2));
+            CHECK(pScene->getTransformsStore()->getWorldOrientation(index1) == pScene2->getTransformsStore()->getWorldOrientation(index2));
+            CHECK(pScene->getTransformsStore()->getWorldScale(index1) == pScene2->getTransformsStore()->getWorldScale(index2));
+        }
+
+        delete pScene2;
+    }
+}
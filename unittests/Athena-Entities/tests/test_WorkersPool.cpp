@@ -0,0 +1,67 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/WorkersPool.h>
+#include <vector>
+
+
+using namespace Athena::Entities;
+
+
+static void incrementTask(void* pUserData, unsigned int task)
+{
+    std::vector<unsigned int>* pCounters = static_cast<std::vector<unsigned int>*>(pUserData);
+    ++(*pCounters)[task];
+}
+
+
+SUITE(WorkersPoolTests)
+{
+    TEST(NumberOfThreads)
+    {
+        WorkersPool pool(3);
+        CHECK_EQUAL(3, pool.getNbThreads());
+    }
+
+
+    TEST(DefaultNumberOfThreads)
+    {
+        WorkersPool pool(0);
+        CHECK(pool.getNbThreads() >= 1);
+    }
+
+
+    TEST(EachTaskIsExecutedOnce)
+    {
+        WorkersPool pool(4);
+        std::vector<unsigned int> counters(1000, 0);
+
+        pool.run(&incrementTask, &counters, (unsigned int) counters.size());
+
+        for (unsigned int i = 0; i < counters.size(); ++i)
+            CHECK_EQUAL(1, counters[i]);
+    }
+
+
+    TEST(SeveralRuns)
+    {
+        WorkersPool pool(4);
+        std::vector<unsigned int> counters(100, 0);
+
+        for (unsigned int i = 0; i < 50; ++i)
+            pool.run(&incrementTask, &counters, (unsigned int) counters.size());
+
+        for (unsigned int i = 0; i < counters.size(); ++i)
+            CHECK_EQUAL(50, counters[i]);
+    }
+
+
+    TEST(NoWorkerThread)
+    {
+        WorkersPool pool(1);
+        std::vector<unsigned int> counters(10, 0);
+
+        pool.run(&incrementTask, &counters, (unsigned int) counters.size());
+
+        for (unsigned int i = 0; i < counters.size(); ++i)
+            CHECK_EQUAL(1, counters[i]);
+    }
+}
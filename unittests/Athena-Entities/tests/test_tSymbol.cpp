@@ -0,0 +1,121 @@
+#include <UnitTest++.h>
+#include <Athena-Entities/tSymbol.h>
+#include <Athena-Entities/tComponentID.h>
+
+
+using namespace Athena::Entities;
+
+
+SUITE(SymbolTests)
+{
+    TEST(EmptySymbol)
+    {
+        tSymbol symbol;
+
+        CHECK(symbol.empty());
+        CHECK_EQUAL("", symbol.str());
+        CHECK(symbol == tSymbol(""));
+        CHECK(symbol == std::string());
+    }
+
+
+    TEST(Interning)
+    {
+        std::string str1 = "test";
+        std::string str2 = "te";
+        str2 += "st";
+
+        tSymbol symbol1(str1);
+        tSymbol symbol2(str2);
+
+        CHECK(!symbol1.empty());
+        CHECK(symbol1 == symbol2);
+        CHECK_EQUAL(symbol1.hash(), symbol2.hash());
+        CHECK_EQUAL(&symbol1.str(), &symbol2.str());
+
+        CHECK(symbol1 != tSymbol("other"));
+    }
+
+
+    TEST(ComparisonWithStrings)
+    {
+        tSymbol symbol("test");
+
+        CHECK(symbol == "test");
+        CHECK("test" == symbol);
+        CHECK(symbol == std::string("test"));
+        CHECK(std::string("test") == symbol);
+        CHECK(symbol != "other");
+        CHECK_EQUAL("test", symbol);
+    }
+
+
+    TEST(Release)
+    {
+        unsigned int nbStrings = tSymbol::getNbStrings();
+
+        {
+            tSymbol symbol1("released");
+            CHECK_EQUAL(nbStrings + 1, tSymbol::getNbStrings());
+
+            tSymbol symbol2(symbol1);
+            tSymbol symbol3("released");
+            CHECK_EQUAL(nbStrings + 1, tSymbol::getNbStrings());
+
+            symbol1 = tSymbol();
+            symbol3 = symbol2;
+            CHECK(symbol2 == "released");
+            CHECK_EQUAL(nbStrings + 1, tSymbol::getNbStrings());
+        }
+
+        CHECK_EQUAL(nbStrings, tSymbol::getNbStrings());
+    }
+
+
+    TEST(PartOfAString)
+    {
+        const char* str = "Transforms://entity:name";
+
+        CHECK(tSymbol("entity") == tSymbol(str + 13, 6));
+        CHECK(tSymbol(str, 0).empty());
+    }
+}
+
+
+SUITE(ComponentIDTests)
+{
+    TEST(Parsing)
+    {
+        tComponentID id("Transforms://entity:name");
+
+        CHECK_EQUAL(COMP_TRANSFORMS, id.type);
+        CHECK_EQUAL("entity", id.strEntity);
+        CHECK_EQUAL("name", id.strName);
+        CHECK_EQUAL("Transforms://entity:name", id.toString());
+    }
+
+
+    TEST(ParsingWithoutEntity)
+    {
+        tComponentID id("Visual://name");
+
+        CHECK_EQUAL(COMP_VISUAL, id.type);
+        CHECK(id.strEntity.empty());
+        CHECK_EQUAL("name", id.strName);
+        CHECK_EQUAL("Visual://name", id.toString());
+    }
+
+
+    TEST(Comparison)
+    {
+        tComponentID id1(COMP_AUDIO, "entity", "name");
+        tComponentID id2("Audio://entity:name");
+        tComponentID id3(COMP_AUDIO, "name");
+
+        CHECK(id1 == id2);
+        CHECK(!(id1 == id3));
+
+        tComponentID::tHash hash;
+        CHECK_EQUAL(hash(id1), hash(id2));
+    }
+}